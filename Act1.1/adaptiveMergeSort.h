@@ -0,0 +1,324 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+/*
+    * Merge Sort adaptativo (corridas naturales) para entradas parcialmente ordenadas, como series de tiempo.
+    *
+    * - Se recorren corridas naturales: las ascendentes se toman tal cual y las estrictamente descendentes se
+    *   invierten (estrictas para no romper la estabilidad). Las corridas cortas se extienden hasta minRun con
+    *   inserción binaria.
+    * - El orden de las mezclas sigue la política de powersort: cada frontera entre dos corridas recibe una
+    *   "potencia" según su posición en el arreglo, y se mezcla mientras la frontera de la pila tenga mayor
+    *   potencia que la nueva. El costo total queda en O(n + n H), donde H es la entropía de las longitudes de
+    *   las corridas: O(n) si la entrada ya está ordenada, O(n log n) en el peor caso.
+    * - Antes de mezclar se recortan con búsqueda exponencial los elementos que ya están en su lugar al inicio de
+    *   la primera corrida y al final de la segunda. Durante la mezcla, si un lado gana MIN_GALLOP veces seguidas
+    *   se pasa a galope: se copia de un jalón el bloque que sigue ganando.
+    * - Se copia a un buffer auxiliar solo la corrida más corta (a lo más n/2 elementos, reservado una vez).
+    *
+    * Es estable.
+*/
+
+const size_t ADAPTIVE_MIN_GALLOP = 7;
+
+template<typename RandomIt, typename Compare = std::less<>>
+void adaptiveMergeSort(RandomIt first, RandomIt last, Compare comp = Compare());
+
+// Implementación
+
+/**
+ * Búsqueda exponencial desde el inicio: cuántos elementos de base[0, len) son menores que key (lower bound)
+ * Complejidad Temporal: O(log p), donde p es la posición encontrada
+ */
+template<typename It, typename T, typename Compare>
+size_t gallopLower(const T& key, It base, size_t len, Compare& comp) {
+    size_t previous = 0, step = 1;
+    while (step <= len && comp(base[step - 1], key)) {
+        previous = step;
+        step *= 2;
+    }
+    return std::lower_bound(base + previous, base + std::min(step, len), key, comp) - base;
+}
+
+/**
+ * Búsqueda exponencial desde el inicio: cuántos elementos de base[0, len) no son mayores que key (upper bound)
+ * Complejidad Temporal: O(log p)
+ */
+template<typename It, typename T, typename Compare>
+size_t gallopUpper(const T& key, It base, size_t len, Compare& comp) {
+    size_t previous = 0, step = 1;
+    while (step <= len && !comp(key, base[step - 1])) {
+        previous = step;
+        step *= 2;
+    }
+    return std::upper_bound(base + previous, base + std::min(step, len), key, comp) - base;
+}
+
+/**
+ * Como gallopLower, pero la búsqueda exponencial empieza desde el final
+ * Complejidad Temporal: O(log (len - p))
+ */
+template<typename It, typename T, typename Compare>
+size_t gallopLowerFromEnd(const T& key, It base, size_t len, Compare& comp) {
+    size_t previous = len, step = 1;
+    while (step <= len && !comp(base[len - step], key)) {
+        previous = len - step;
+        step *= 2;
+    }
+    size_t low = step <= len ? len - step + 1 : 0;
+    return std::lower_bound(base + low, base + previous, key, comp) - base;
+}
+
+/**
+ * Como gallopUpper, pero la búsqueda exponencial empieza desde el final
+ * Complejidad Temporal: O(log (len - p))
+ */
+template<typename It, typename T, typename Compare>
+size_t gallopUpperFromEnd(const T& key, It base, size_t len, Compare& comp) {
+    size_t previous = len, step = 1;
+    while (step <= len && comp(key, base[len - step])) {
+        previous = len - step;
+        step *= 2;
+    }
+    size_t low = step <= len ? len - step + 1 : 0;
+    return std::upper_bound(base + low, base + previous, key, comp) - base;
+}
+
+/**
+ * Potencia de la frontera entre las corridas [s1, s1 + n1) y [s1 + n1, s1 + n1 + n2) en un arreglo de n:
+ * el primer bit en que difieren los puntos medios de ambas corridas, vistos como fracciones de n
+ * Complejidad Temporal: O(log n)
+ */
+inline int powersortPower(size_t s1, size_t n1, size_t n2, size_t n) {
+    int power = 0;
+    size_t a = 2 * s1 + n1;   // 2 * punto medio de la primera corrida
+    size_t b = a + n1 + n2;   // 2 * punto medio de la segunda
+    while (true) {
+        ++power;
+        if (a >= n) {
+            a -= n;
+            b -= n;
+        } else if (b >= n) {
+            break;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+template<typename RandomIt, typename Compare>
+class AdaptiveMerger {
+public:
+    using Value = typename std::iterator_traits<RandomIt>::value_type;
+
+    AdaptiveMerger(RandomIt first, size_t n, Compare& comp) : first(first), comp(comp) {
+        buffer.reserve(n / 2 + 1);
+    }
+
+    /**
+     * Mezcla las corridas adyacentes [a, a + na) y [a + na, a + na + nb)
+     * Complejidad Temporal: O(na + nb), menos si hay bloques largos que ya están en orden
+     */
+    void merge(size_t a, size_t na, size_t nb) {
+        // Los elementos de la primera corrida que no superan al primero de la segunda ya están en su lugar
+        size_t skip = gallopUpper(first[a + na], first + a, na, comp);
+        a += skip;
+        na -= skip;
+        if (na == 0) {
+            return;
+        }
+        // Y los de la segunda que no son menores que el último de la primera también
+        nb = gallopLowerFromEnd(first[a + na - 1], first + a + na, nb, comp);
+        if (nb == 0) {
+            return;
+        }
+        if (na <= nb) {
+            mergeLow(a, na, nb);
+        } else {
+            mergeHigh(a, na, nb);
+        }
+    }
+
+private:
+    // Copia la primera corrida al buffer y mezcla hacia adelante
+    void mergeLow(size_t a, size_t na, size_t nb) {
+        buffer.assign(std::make_move_iterator(first + a), std::make_move_iterator(first + a + na));
+        auto left = buffer.begin();
+        RandomIt right = first + a + na;
+        RandomIt dest = first + a;
+        size_t i = 0, j = 0;
+
+        while (i < na && j < nb) {
+            size_t winsLeft = 0, winsRight = 0;
+            while (i < na && j < nb && winsLeft < ADAPTIVE_MIN_GALLOP && winsRight < ADAPTIVE_MIN_GALLOP) {
+                if (comp(right[j], left[i])) {
+                    *dest++ = std::move(right[j++]);
+                    winsRight++;
+                    winsLeft = 0;
+                } else {
+                    *dest++ = std::move(left[i++]);
+                    winsLeft++;
+                    winsRight = 0;
+                }
+            }
+
+            // Galope: se copian bloques completos mientras sigan siendo largos
+            size_t blockLeft = ADAPTIVE_MIN_GALLOP, blockRight = ADAPTIVE_MIN_GALLOP;
+            while (i < na && j < nb && (blockLeft >= ADAPTIVE_MIN_GALLOP || blockRight >= ADAPTIVE_MIN_GALLOP)) {
+                blockLeft = gallopUpper(right[j], left + i, na - i, comp);
+                dest = std::move(left + i, left + i + blockLeft, dest);
+                i += blockLeft;
+                if (i == na) {
+                    break;
+                }
+                blockRight = gallopLower(left[i], right + j, nb - j, comp);
+                dest = std::move(right + j, right + j + blockRight, dest);
+                j += blockRight;
+            }
+        }
+        // Lo que quede de la segunda corrida ya está en su lugar
+        std::move(left + i, left + na, dest);
+    }
+
+    // Copia la segunda corrida al buffer y mezcla hacia atrás
+    void mergeHigh(size_t a, size_t na, size_t nb) {
+        buffer.assign(std::make_move_iterator(first + a + na), std::make_move_iterator(first + a + na + nb));
+        RandomIt left = first + a;
+        auto right = buffer.begin();
+        RandomIt dest = first + a + na + nb;
+        size_t i = na, j = nb;
+
+        while (i > 0 && j > 0) {
+            size_t winsLeft = 0, winsRight = 0;
+            while (i > 0 && j > 0 && winsLeft < ADAPTIVE_MIN_GALLOP && winsRight < ADAPTIVE_MIN_GALLOP) {
+                // Con empate el de la segunda corrida va después
+                if (comp(right[j - 1], left[i - 1])) {
+                    *--dest = std::move(left[--i]);
+                    winsLeft++;
+                    winsRight = 0;
+                } else {
+                    *--dest = std::move(right[--j]);
+                    winsRight++;
+                    winsLeft = 0;
+                }
+            }
+
+            size_t blockLeft = ADAPTIVE_MIN_GALLOP, blockRight = ADAPTIVE_MIN_GALLOP;
+            while (i > 0 && j > 0 && (blockLeft >= ADAPTIVE_MIN_GALLOP || blockRight >= ADAPTIVE_MIN_GALLOP)) {
+                size_t position = gallopUpperFromEnd(right[j - 1], left, i, comp);
+                blockLeft = i - position;
+                dest = std::move_backward(left + position, left + i, dest);
+                i = position;
+                if (i == 0) {
+                    break;
+                }
+                position = gallopLowerFromEnd(left[i - 1], right, j, comp);
+                blockRight = j - position;
+                dest = std::move_backward(right + position, right + j, dest);
+                j = position;
+            }
+        }
+        // Lo que quede de la primera corrida ya está en su lugar
+        std::move_backward(right, right + j, dest);
+    }
+
+    RandomIt first;
+    Compare& comp;
+    std::vector<Value> buffer;
+};
+
+/**
+ * Longitud mínima de corrida: entre 32 y 64, de modo que n / minRun sea potencia de 2 o un poco menos
+ * Complejidad Temporal: O(log n)
+ */
+inline size_t adaptiveMinRun(size_t n) {
+    size_t extra = 0;
+    while (n >= 64) {
+        extra |= n & 1;
+        n >>= 1;
+    }
+    return n + extra;
+}
+
+/**
+ * Encuentra la corrida natural que empieza en start (invirtiéndola si es descendente) y la extiende hasta
+ * minRun elementos con inserción binaria. Devuelve su longitud
+ * Complejidad Temporal: O(k) para una corrida natural de k elementos; O(minRun^2) movimientos si se extiende
+ */
+template<typename RandomIt, typename Compare>
+size_t nextRun(RandomIt first, size_t start, size_t n, size_t minRun, Compare& comp) {
+    size_t end = start + 1;
+    if (end < n) {
+        if (comp(first[end], first[start])) {
+            while (end < n && comp(first[end], first[end - 1])) {
+                ++end;
+            }
+            std::reverse(first + start, first + end);
+        } else {
+            while (end < n && !comp(first[end], first[end - 1])) {
+                ++end;
+            }
+        }
+    }
+
+    size_t target = std::min(n, start + minRun);
+    for (; end < target; ++end) {
+        auto value = std::move(first[end]);
+        RandomIt position = std::upper_bound(first + start, first + end, value, comp);
+        std::move_backward(position, first + end, first + end + 1);
+        *position = std::move(value);
+    }
+    return end - start;
+}
+
+/**
+ * Merge Sort adaptativo con política de mezcla powersort
+ * Complejidad Temporal: O(n) si la entrada ya está ordenada (o invertida); O(n log n) en el peor caso
+ * Complejidad Espacial: O(n / 2) para el buffer más O(log n) para la pila de corridas
+ */
+template<typename RandomIt, typename Compare>
+void adaptiveMergeSort(RandomIt first, RandomIt last, Compare comp) {
+    size_t n = static_cast<size_t>(last - first);
+    if (n < 2) {
+        return;
+    }
+
+    struct Run {
+        size_t start, length;
+        int power;  // Potencia de la frontera con la corrida anterior en la pila
+    };
+    std::vector<Run> stack;
+    AdaptiveMerger<RandomIt, Compare> merger(first, n, comp);
+    size_t minRun = adaptiveMinRun(n);
+
+    auto mergeTop = [&]() {
+        Run right = stack.back();
+        stack.pop_back();
+        Run& left = stack.back();
+        merger.merge(left.start, left.length, right.length);
+        left.length += right.length;
+    };
+
+    for (size_t start = 0; start < n; ) {
+        size_t length = nextRun(first, start, n, minRun, comp);
+        int power = 0;
+        if (!stack.empty()) {
+            power = powersortPower(stack.back().start, stack.back().length, length, n);
+            while (stack.size() > 1 && stack.back().power > power) {
+                mergeTop();
+            }
+        }
+        stack.push_back({start, length, power});
+        start += length;
+    }
+    while (stack.size() > 1) {
+        mergeTop();
+    }
+}
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <chrono>
+#include <charconv>
+#include <stdexcept>
+#include <algorithm>
+#include <unistd.h>
+#include "mergeSort.h"
+#include "numberIO.h"
+
+/*
+    * Ordenamiento externo para entradas que no caben en memoria.
+    *
+    * 1. Se leen los valores en bloques que caben en el presupuesto de memoria (la mitad del presupuesto,
+    *    porque merge necesita otro tanto de espacio auxiliar), cada bloque se ordena con mergeSort y se
+    *    escribe como corrida binaria (doubles en el formato nativo) en el directorio temporal.
+    * 2. Las k corridas se mezclan con un árbol de perdedores: sacar el mínimo y reponerlo cuesta log2(k)
+    *    comparaciones, una por nivel, sin comparar entre hermanos como un heap.
+    * 3. La E/S de la mezcla usa doble buffer: mientras se consume un bloque de una corrida, el siguiente se lee
+    *    en segundo plano (std::async); la salida también se formatea en un buffer mientras el anterior se escribe.
+    *
+    * El resto del presupuesto se reparte entre los buffers de lectura de cada corrida y los de salida.
+    * Cada corrida se crea con mkstemp (nombre único, así varios ordenamientos pueden compartir el directorio) y
+    * RunFiles las borra todas al salir, también si hay una excepción a media fase.
+*/
+
+struct ExternalSortStats {
+    size_t values = 0;
+    size_t runs = 0;
+    double runMillis = 0;    // Lectura, ordenamiento y escritura de las corridas
+    double mergeMillis = 0;  // Mezcla de las corridas y escritura de la salida
+};
+
+ExternalSortStats externalSort(NumberReader& in, size_t count, std::FILE* out, size_t memoryBudget,
+                               const std::string& tempDirectory);
+
+// Implementación
+
+/**
+ * Árbol de perdedores sobre k corridas. tree[0] es la corrida ganadora (la de menor cabeza) y cada nodo
+ * interno guarda la perdedora de su partido. Una corrida agotada pierde contra todas.
+ * Complejidad Temporal: O(k) para construirlo, O(log k) para reponer al ganador
+ */
+class LoserTree {
+public:
+    LoserTree(const std::vector<double>& heads, const std::vector<bool>& exhausted)
+        : heads(heads), exhausted(exhausted), k(heads.size()), tree(std::max<size_t>(k, 1)) {
+        std::vector<size_t> winners(2 * k);
+        for (size_t i = 0; i < k; ++i) {
+            winners[k + i] = i;
+        }
+        for (size_t node = k - 1; node >= 1; --node) {
+            size_t a = winners[2 * node], b = winners[2 * node + 1];
+            winners[node] = beats(a, b) ? a : b;
+            tree[node] = beats(a, b) ? b : a;
+        }
+        tree[0] = k > 1 ? winners[1] : 0;
+    }
+
+    size_t winner() const { return tree[0]; }
+
+    // Vuelve a jugar los partidos desde la hoja del ganador después de que su cabeza cambió
+    void replay() {
+        size_t winner = tree[0];
+        for (size_t node = (winner + k) / 2; node >= 1; node /= 2) {
+            if (beats(tree[node], winner)) {
+                std::swap(tree[node], winner);
+            }
+        }
+        tree[0] = winner;
+    }
+
+private:
+    bool beats(size_t a, size_t b) const {
+        if (exhausted[a] || exhausted[b]) {
+            return !exhausted[a];
+        }
+        return heads[a] < heads[b] || (heads[a] == heads[b] && a < b);
+    }
+
+    const std::vector<double>& heads;
+    const std::vector<bool>& exhausted;
+    size_t k;
+    std::vector<size_t> tree;
+};
+
+/**
+ * Rutas de las corridas temporales; el destructor las borra todas
+ */
+class RunFiles {
+public:
+    RunFiles() = default;
+    RunFiles(const RunFiles&) = delete;
+    RunFiles& operator=(const RunFiles&) = delete;
+    ~RunFiles() {
+        for (const std::string& path : paths) {
+            std::remove(path.c_str());
+        }
+    }
+
+    // Crea una corrida vacía con nombre único en directory y la abre para escribir
+    std::FILE* create(const std::string& directory) {
+        std::string path = directory + "/merge_run_XXXXXX";
+        int fd = ::mkstemp(path.data());
+        if (fd < 0) {
+            throw std::runtime_error("No se pudo crear una corrida en " + directory);
+        }
+        paths.push_back(path);
+        std::FILE* file = ::fdopen(fd, "wb");
+        if (!file) {
+            ::close(fd);
+            throw std::runtime_error("No se pudo abrir la corrida " + path);
+        }
+        return file;
+    }
+
+    const std::vector<std::string>& all() const { return paths; }
+    size_t size() const { return paths.size(); }
+
+private:
+    std::vector<std::string> paths;
+};
+
+/**
+ * Lector de una corrida binaria con doble buffer: el siguiente bloque se lee en segundo plano
+ */
+class RunReader {
+public:
+    RunReader(const std::string& path, size_t blockValues) : path(path), current(blockValues), next(blockValues), position(0) {
+        file = std::fopen(path.c_str(), "rb");
+        if (!file) {
+            throw std::runtime_error("No se pudo abrir la corrida " + path);
+        }
+        current.resize(std::fread(current.data(), sizeof(double), current.size(), file));
+        prefetch();
+    }
+    RunReader(const RunReader&) = delete;
+    RunReader& operator=(const RunReader&) = delete;
+    ~RunReader() {
+        if (pending.valid()) {
+            pending.wait();
+        }
+        std::fclose(file);
+    }
+
+    bool empty() const { return position >= current.size(); }
+    double head() const { return current[position]; }
+
+    // Avanza al siguiente valor; al terminar el bloque cambia al que se leyó en segundo plano
+    void pop() {
+        if (++position < current.size()) {
+            return;
+        }
+        size_t read = pending.get();
+        std::swap(current, next);
+        current.resize(read);
+        position = 0;
+        if (read > 0) {
+            prefetch();
+        }
+    }
+
+private:
+    void prefetch() {
+        next.resize(next.capacity());
+        pending = std::async(std::launch::async, [this]() {
+            return std::fread(next.data(), sizeof(double), next.size(), file);
+        });
+    }
+
+    std::string path;
+    std::FILE* file;
+    std::vector<double> current, next;
+    size_t position;
+    std::future<size_t> pending;
+};
+
+/**
+ * Ordena count valores leídos de in (texto o binario) y escribe el resultado en out, separados por espacios,
+ * usando como máximo memoryBudget bytes para los datos
+ * Complejidad Temporal: O(n log n) comparaciones; O(n) lecturas y escrituras de disco por fase
+ */
+inline ExternalSortStats externalSort(NumberReader& in, size_t count, std::FILE* out, size_t memoryBudget,
+                                      const std::string& tempDirectory) {
+    using Clock = std::chrono::high_resolution_clock;
+    ExternalSortStats stats;
+
+    // mergeSort usa índices int, así que un bloque no puede pasar de 2^31 - 1 valores
+    size_t chunkValues = std::max<size_t>(1024, memoryBudget / (2 * sizeof(double)));
+    chunkValues = std::min<size_t>(chunkValues, 0x7FFFFFFF);
+
+    // Fase 1: corridas ordenadas
+    auto start = Clock::now();
+    RunFiles runs;  // Se declara antes que los lectores: borra las corridas después de cerrarlas
+    size_t remaining;
+    {
+        std::vector<double> chunk;
+        chunk.reserve(std::min(chunkValues, count));
+        for (remaining = count; remaining > 0; ) {
+            chunk.resize(std::min(chunkValues, remaining));
+            size_t size = in.read(chunk.data(), chunk.size());
+            if (size == 0) {
+                break;
+            }
+            chunk.resize(size);
+            remaining -= size;
+            mergeSort(chunk, 0, static_cast<int>(size) - 1);
+
+            std::FILE* file = runs.create(tempDirectory);
+            bool written = std::fwrite(chunk.data(), sizeof(double), size, file) == size;
+            if (std::fclose(file) != 0 || !written) {
+                throw std::runtime_error("No se pudo escribir la corrida " + runs.all().back());
+            }
+        }
+    }
+    stats.runs = runs.size();
+    count -= remaining;  // Si la entrada traía menos de count valores
+    stats.values = count;
+    stats.runMillis = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // Fase 2: mezcla de k vías. Cada corrida tiene dos bloques de lectura y la salida dos de escritura
+    start = Clock::now();
+    size_t k = runs.size();
+    size_t blockValues = std::max<size_t>(4096, memoryBudget / (sizeof(double) * (2 * k + 2)));
+
+    std::vector<std::unique_ptr<RunReader>> readers;
+    std::vector<double> heads(k);
+    std::vector<bool> exhausted(k);
+    for (size_t r = 0; r < k; ++r) {
+        readers.push_back(std::make_unique<RunReader>(runs.all()[r], blockValues));
+        exhausted[r] = readers[r]->empty();
+        heads[r] = exhausted[r] ? 0 : readers[r]->head();
+    }
+
+    // Los buffers de salida ocupan lo mismo que un bloque de lectura; cada double ocupa a lo más
+    // 24 caracteres con std::to_chars más el separador
+    const size_t MAX_CHARS = 32;
+    std::vector<char> output(blockValues * sizeof(double)), flushing(blockValues * sizeof(double));
+    std::future<bool> writing;
+    size_t used = 0;
+    auto waitWrite = [&]() {
+        if (writing.valid() && !writing.get()) {
+            throw std::runtime_error("No se pudo escribir la salida");
+        }
+    };
+    auto flush = [&]() {
+        waitWrite();
+        std::swap(output, flushing);
+        writing = std::async(std::launch::async, [&flushing, out, used]() {
+            return std::fwrite(flushing.data(), 1, used, out) == used;
+        });
+        used = 0;
+    };
+
+    if (k > 0) {
+        LoserTree tree(heads, exhausted);
+        for (size_t written = 0; written < count; ++written) {
+            size_t r = tree.winner();
+            if (used + MAX_CHARS > output.size()) {
+                flush();
+            }
+            used = std::to_chars(output.data() + used, output.data() + output.size(), heads[r]).ptr - output.data();
+            output[used++] = ' ';
+
+            readers[r]->pop();
+            exhausted[r] = readers[r]->empty();
+            if (!exhausted[r]) {
+                heads[r] = readers[r]->head();
+            }
+            tree.replay();
+        }
+    }
+    flush();
+    waitWrite();
+    if (std::fflush(out) != 0 || std::ferror(out)) {
+        throw std::runtime_error("No se pudo escribir la salida");
+    }
+    readers.clear();
+    stats.mergeMillis = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return stats;
+}
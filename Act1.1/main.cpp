@@ -1,6 +1,18 @@
 #include <iostream>
 #include <vector>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
 #include "mergeSort.h"
+#include "parallelMergeSort.h"
+#include "simdMergeSort.h"
+#include "externalSort.h"
+#include "adaptiveMergeSort.h"
+#include "../Support/Utilities/measureTime.h"
 
 /*
     * Implementación de Merge Sort 
@@ -99,29 +111,254 @@ void mergeSort(std::vector<double>& arr, int left, int right) {
 }
 
 
-// Main function
-int main() {
-    int N;
-    std::cin >> N;
+/**
+ * Benchmark de escalamiento: ordena los mismos n valores aleatorios con parallelMergeSort usando
+ * 1, 2, 4, ... hasta maxThreads hilos y reporta tiempo, aceleración respecto a un hilo y si el resultado
+ * está ordenado. Como referencia también mide mergeSort, bottomUpMergeSort y std::sort.
+ * Complejidad Temporal: O(n log n) por cada número de hilos
+ */
+void runParallelBenchmark(size_t n, unsigned maxThreads) {
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> pick(0.0, 1e6);
+    std::vector<double> input(n);
+    for (double& value : input) {
+        value = pick(gen);
+    }
 
-    std::vector<double> arr(N);
-    for (int i = 0; i < N; ++i) {
-        std::cin >> arr[i];
+    std::vector<double> arr(input);
+    double recursive = ExecutionTimer::measureExecutionTime([&]() { mergeSort(arr, 0, arr.size() - 1); });
+    arr = input;
+    double bottomUp = ExecutionTimer::measureExecutionTime([&]() { bottomUpMergeSort(arr.begin(), arr.end()); });
+    arr = input;
+    double reference = ExecutionTimer::measureExecutionTime([&]() { std::sort(arr.begin(), arr.end()); });
+    std::cout << "Elementos: " << n << ", hilos disponibles: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "mergeSort: " << recursive << " ms, bottomUpMergeSort: " << bottomUp << " ms, std::sort: "
+              << reference << " ms" << std::endl;
+
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
     }
+    threadCounts.push_back(maxThreads);
 
-    std::cout << "Array original:" << std::endl;
-    for (const auto& num : arr) {
-        std::cout << num << " ";
+    double single = 0;
+    for (unsigned threads : threadCounts) {
+        arr = input;
+        double time = ExecutionTimer::measureExecutionTime([&]() { parallelMergeSort(arr, threads); });
+        if (threads == 1) {
+            single = time;
+        }
+        std::cout << "Hilos: " << threads << " - " << time << " ms, aceleración: " << single / time
+                  << (std::is_sorted(arr.begin(), arr.end()) ? "" : " (NO ORDENADO)") << std::endl;
     }
-    std::cout << std::endl;
+}
 
-    mergeSort(arr, 0, arr.size() - 1);
+/**
+ * Benchmark del kernel vectorizado: ordena los mismos n valores aleatorios con mergeSort, std::sort y
+ * simdMergeSort en cada nivel de instrucciones que soporta el procesador, y verifica que el resultado
+ * coincida con el de std::sort.
+ * Complejidad Temporal: O(n log n) por cada variante
+ */
+void runSimdBenchmark(size_t n) {
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> pick(-1e6, 1e6);
+    std::vector<double> input(n);
+    for (double& value : input) {
+        value = pick(gen);
+    }
 
-    std::cout << "Array ordenado:" << std::endl;
-    for (const auto& num : arr) {
-        std::cout << num << " ";
+    std::vector<double> expected(input);
+    double reference = ExecutionTimer::measureExecutionTime([&]() { std::sort(expected.begin(), expected.end()); });
+    std::vector<double> arr(input);
+    double recursive = ExecutionTimer::measureExecutionTime([&]() { mergeSort(arr, 0, arr.size() - 1); });
+
+    SimdLevel detected = detectSimdLevel();
+    std::cout << "Elementos: " << n << ", nivel detectado: " << simdLevelName(detected) << std::endl;
+    std::cout << "mergeSort: " << recursive << " ms, std::sort: " << reference << " ms" << std::endl;
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (level > detected) {
+            break;
+        }
+        arr = input;
+        double time = ExecutionTimer::measureExecutionTime([&]() { simdMergeSort(arr, level); });
+        std::cout << "simdMergeSort (" << simdLevelName(level) << "): " << time << " ms"
+                  << (arr == expected ? "" : " (RESULTADO DISTINTO)") << std::endl;
+    }
+
+    // Con NaN y ceros con signo el resultado debe ser una permutación bit a bit: los números ordenados
+    // (los -0.0 antes que los +0.0) y después todos los NaN
+    std::vector<double> special(input.begin(), input.begin() + std::min<size_t>(n, 40));
+    for (size_t i = 0; i < special.size(); ++i) {
+        if (i % 13 == 0) {
+            special[i] = std::numeric_limits<double>::quiet_NaN();
+        } else if (i % 3 == 0) {
+            special[i] = i % 2 == 0 ? -0.0 : 0.0;
+        }
+    }
+    std::vector<double> numbers;
+    std::copy_if(special.begin(), special.end(), std::back_inserter(numbers), [](double v) { return !std::isnan(v); });
+    std::sort(numbers.begin(), numbers.end(),
+              [](double a, double b) { return a < b || (a == b && std::signbit(a) && !std::signbit(b)); });
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        arr = special;
+        simdMergeSort(arr, level);
+        bool permutation = arr.size() == special.size() &&
+                           (numbers.empty() ||
+                            std::memcmp(numbers.data(), arr.data(), numbers.size() * sizeof(double)) == 0) &&
+                           std::all_of(arr.begin() + numbers.size(), arr.end(), [](double v) { return std::isnan(v); });
+        std::cout << "Con NaN y ±0 (" << simdLevelName(level)
+                  << "): " << (permutation ? "permutación" : "SE PERDIERON VALORES") << std::endl;
+    }
+}
+
+/**
+ * Benchmark por distribución de la entrada: aleatoria, ordenada, invertida, diente de sierra (corridas
+ * ascendentes de 1000 valores) y casi ordenada (1% de posiciones intercambiadas al azar). Compara
+ * mergeSort, bottomUpMergeSort, adaptiveMergeSort y std::stable_sort, y verifica los resultados.
+ * Complejidad Temporal: O(n log n) por variante y distribución
+ */
+void runAdaptiveBenchmark(size_t n) {
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> pick(0.0, 1e6);
+    std::uniform_int_distribution<size_t> position(0, n - 1);
+
+    std::vector<double> random(n);
+    for (double& value : random) {
+        value = pick(gen);
+    }
+    std::vector<double> sorted(random);
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<double> sawtooth(n);
+    for (size_t i = 0; i < n; ++i) {
+        sawtooth[i] = static_cast<double>(i % 1000);
+    }
+    std::vector<double> nearlySorted(sorted);
+    for (size_t swaps = 0; swaps < n / 100; ++swaps) {
+        std::swap(nearlySorted[position(gen)], nearlySorted[position(gen)]);
+    }
+
+    std::vector<std::pair<std::string, std::vector<double>>> inputs = {
+        {"aleatoria", random},
+        {"ordenada", sorted},
+        {"invertida", std::vector<double>(sorted.rbegin(), sorted.rend())},
+        {"diente de sierra", sawtooth},
+        {"casi ordenada", nearlySorted},
+    };
+
+    std::cout << "Elementos: " << n << std::endl;
+    for (const auto& [name, input] : inputs) {
+        std::vector<double> expected(input);
+        double stable = ExecutionTimer::measureExecutionTime([&]() { std::stable_sort(expected.begin(), expected.end()); });
+        std::vector<double> arr(input);
+        double recursive = ExecutionTimer::measureExecutionTime([&]() { mergeSort(arr, 0, arr.size() - 1); });
+        arr = input;
+        double bottomUp = ExecutionTimer::measureExecutionTime([&]() { bottomUpMergeSort(arr.begin(), arr.end()); });
+        arr = input;
+        double adaptive = ExecutionTimer::measureExecutionTime([&]() { adaptiveMergeSort(arr.begin(), arr.end()); });
+        std::cout << name << " - mergeSort: " << recursive << " ms, bottomUpMergeSort: " << bottomUp
+                  << " ms, adaptiveMergeSort: " << adaptive << " ms, std::stable_sort: " << stable << " ms"
+                  << (arr == expected ? "" : " (RESULTADO DISTINTO)") << std::endl;
+    }
+}
+
+// Uso: ./main [--binary] [--no-original] [archivo] (sin archivo lee la entrada estándar)
+//      ./main --parallel-benchmark [n] [hilos máximos]
+//      ./main --simd-benchmark [n]
+//      ./main --adaptive-benchmark [n]
+//      ./main --external [presupuesto en MB] [directorio temporal] [--binary] [archivo] > salida.txt
+// --binary: la entrada son doubles little-endian de 8 bytes sin encabezado
+// --no-original: no imprime el arreglo sin ordenar
+int main(int argc, char* argv[]) {
+    // Las opciones pueden ir en cualquier posición; el resto de los argumentos se interpreta por posición
+    bool binary = false, printOriginal = true;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--binary") {
+            binary = true;
+        } else if (arg == "--no-original") {
+            printOriginal = false;
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    std::string mode = args.empty() ? "" : args[0];
+    if (mode == "--parallel-benchmark") {
+        size_t n = args.size() > 1 ? std::stoull(args[1]) : 100000000;
+        unsigned maxThreads = args.size() > 2 ? std::stoul(args[2]) : std::max(1u, std::thread::hardware_concurrency());
+        runParallelBenchmark(n, maxThreads);
+        return 0;
+    }
+    if (mode == "--external") {
+        size_t budget = (args.size() > 1 ? std::stoull(args[1]) : 256) << 20;
+        std::string tempDirectory = args.size() > 2 ? args[2] : ".";
+        // Una tubería se lee por bloques de 1 MB para no pasar del presupuesto
+        MappedInput input(args.size() > 3 ? args[3].c_str() : nullptr, 1 << 20);
+        NumberReader reader(input, binary);
+        size_t count = 0;
+        reader.readCount(count);
+
+        // Se atrapa para que las corridas temporales se borren al salir de externalSort
+        ExternalSortStats stats;
+        try {
+            stats = externalSort(reader, count, stdout, budget, tempDirectory);
+        } catch (const std::exception& error) {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+        std::fputc('\n', stdout);
+        double gigabytes = stats.values * sizeof(double) / 1e9;
+        double totalMillis = stats.runMillis + stats.mergeMillis;
+        std::cerr << "Valores: " << stats.values << ", corridas: " << stats.runs << ", presupuesto: "
+                  << (budget >> 20) << " MB" << std::endl;
+        std::cerr << "Corridas: " << stats.runMillis << " ms, mezcla: " << stats.mergeMillis << " ms, total: "
+                  << (totalMillis > 0 ? gigabytes / (totalMillis / 1000.0) : 0.0) << " GB/s" << std::endl;
+        return 0;
+    }
+    if (mode == "--adaptive-benchmark") {
+        runAdaptiveBenchmark(args.size() > 1 ? std::stoull(args[1]) : 10000000);
+        return 0;
+    }
+    if (mode == "--simd-benchmark") {
+        runSimdBenchmark(args.size() > 1 ? std::stoull(args[1]) : 10000000);
+        return 0;
+    }
+
+    MappedInput input(args.empty() ? nullptr : args[0].c_str());
+    NumberReader reader(input.begin(), input.end(), binary);
+    size_t N = 0;
+    reader.readCount(N);
+
+    // Si la entrada trae menos de N valores los faltantes quedan en 0, como con std::cin
+    std::vector<double> arr(N);
+    reader.read(arr.data(), N);
+
+    // La salida se vacía explícitamente para detectar errores de escritura (por ejemplo, disco lleno)
+    try {
+        BufferedWriter output(stdout);
+        if (printOriginal) {
+            output.write("Array original:\n");
+            for (const auto& num : arr) {
+                output.write(num);
+                output.write(" ");
+            }
+            output.write("\n");
+        }
+
+        mergeSort(arr, 0, arr.size() - 1);
+
+        output.write("Array ordenado:\n");
+        for (const auto& num : arr) {
+            output.write(num);
+            output.write(" ");
+        }
+        output.write("\n");
+        output.flush();
+    } catch (const std::runtime_error& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
     }
-    std::cout << std::endl;
 
     return 0;
-}
\ No newline at end of file
+}
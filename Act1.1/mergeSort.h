@@ -1,6 +1,116 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
 
 void merge(std::vector<double>& arr, int left, int middle, int right);
-void mergeSort(std::vector<double>& arr, int left, int right);
\ No newline at end of file
+void mergeSort(std::vector<double>& arr, int left, int right);
+
+/*
+    * Merge Sort ascendente (no recursivo) genérico sobre iteradores de acceso aleatorio y comparadores.
+    *
+    * - Índices size_t: funciona con más de 2^31 elementos.
+    * - Un solo buffer auxiliar reservado al inicio; cada pasada mezcla del arreglo al buffer o del buffer al
+    *   arreglo, alternando, así que no se copian los datos de regreso en cada nivel.
+    * - Primero se ordenan por inserción bloques de BOTTOM_UP_INSERTION_RUN elementos, lo que ahorra las
+    *   primeras cinco pasadas.
+    * - Si el último elemento de una corrida no es mayor que el primero de la siguiente, la mezcla se reduce
+    *   a mover la corrida completa.
+    *
+    * Es estable: con empate se toma primero el elemento de la corrida izquierda.
+*/
+
+const size_t BOTTOM_UP_INSERTION_RUN = 32;
+
+template<typename RandomIt, typename Compare = std::less<>>
+void bottomUpMergeSort(RandomIt first, RandomIt last, Compare comp = Compare());
+
+// Implementación
+
+/**
+ * Ordena por inserción [first, last)
+ * Complejidad Temporal: O(k^2) con k = last - first
+ */
+template<typename RandomIt, typename Compare>
+void insertionSortRun(RandomIt first, RandomIt last, Compare& comp) {
+    if (first == last) {
+        return;
+    }
+    for (RandomIt current = first + 1; current != last; ++current) {
+        auto value = std::move(*current);
+        RandomIt hole = current;
+        while (hole != first && comp(value, *(hole - 1))) {
+            *hole = std::move(*(hole - 1));
+            --hole;
+        }
+        *hole = std::move(value);
+    }
+}
+
+/**
+ * Una pasada: mezcla cada par de corridas consecutivas de tamaño width de src en dst
+ * Complejidad Temporal: O(n)
+ */
+template<typename SrcIt, typename DstIt, typename Compare>
+void mergePass(SrcIt src, DstIt dst, size_t n, size_t width, Compare& comp) {
+    for (size_t left = 0; left < n; left += 2 * width) {
+        size_t middle = std::min(left + width, n);
+        size_t right = std::min(left + 2 * width, n);
+
+        // Corridas ya ordenadas entre sí (o sin pareja): se mueven sin comparar elemento por elemento
+        if (middle == right || !comp(src[middle], src[middle - 1])) {
+            std::move(src + left, src + right, dst + left);
+            continue;
+        }
+
+        size_t i = left, j = middle, k = left;
+        while (i < middle && j < right) {
+            if (comp(src[j], src[i])) {
+                dst[k++] = std::move(src[j++]);
+            } else {
+                dst[k++] = std::move(src[i++]);
+            }
+        }
+        std::move(src + i, src + middle, dst + k);
+        std::move(src + j, src + right, dst + k + (middle - i));
+    }
+}
+
+/**
+ * Merge Sort ascendente
+ * Complejidad Temporal: O(n log n) en todos los casos; O(n) por pasada si la entrada ya está ordenada
+ * Complejidad Espacial: O(n), un solo buffer auxiliar
+ */
+template<typename RandomIt, typename Compare>
+void bottomUpMergeSort(RandomIt first, RandomIt last, Compare comp) {
+    size_t n = static_cast<size_t>(last - first);
+    if (n < 2) {
+        return;
+    }
+
+    for (size_t left = 0; left < n; left += BOTTOM_UP_INSERTION_RUN) {
+        insertionSortRun(first + left, first + std::min(left + BOTTOM_UP_INSERTION_RUN, n), comp);
+    }
+    if (n <= BOTTOM_UP_INSERTION_RUN) {
+        return;
+    }
+
+    std::vector<typename std::iterator_traits<RandomIt>::value_type> buffer(
+        std::make_move_iterator(first), std::make_move_iterator(last));
+    bool inBuffer = true;
+    for (size_t width = BOTTOM_UP_INSERTION_RUN; width < n; width *= 2) {
+        if (inBuffer) {
+            mergePass(buffer.begin(), first, n, width, comp);
+        } else {
+            mergePass(first, buffer.begin(), n, width, comp);
+        }
+        inBuffer = !inBuffer;
+    }
+    if (inBuffer) {
+        std::move(buffer.begin(), buffer.end(), first);
+    }
+}
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <cstddef>
+#include <algorithm>
+#include <charconv>
+#include <bit>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+    * Capa de entrada y salida de números para el ordenador.
+    *
+    * - MappedInput mapea el archivo de entrada (o la entrada estándar si está redirigida desde un archivo) con
+    *   mmap, sin copiarlo; si la entrada es una tubería se lee completa a memoria, o por bloques de tamaño fijo
+    *   si se pide un buffer de flujo (para el ordenamiento externo, donde la entrada no cabe en memoria).
+    * - NumberReader recorre esos bytes en uno de dos formatos:
+    *     texto: la cantidad N y después los valores, separados por espacios o saltos de línea. Cada número se
+    *            convierte con std::from_chars (sin locale ni flujos); lo que from_chars no acepta, como un
+    *            '+' inicial, pasa por strtod.
+    *     binario: doubles IEEE-754 de 8 bytes en little-endian, sin encabezado: N es el tamaño entre 8 (leída
+    *              por bloques no se conoce el tamaño, así que N es "hasta el final").
+    *   Con una entrada por bloques, el lector rellena el buffer cuando se acaba y conserva el número que quedó
+    *   cortado en la frontera.
+    * - BufferedWriter acumula la salida en un buffer grande y la escribe con fwrite; los valores se formatean
+    *   con std::to_chars igual que std::cout por omisión (%g con 6 dígitos significativos).
+*/
+
+class MappedInput {
+public:
+    // streamBuffer > 0: si la entrada no se puede mapear se lee por bloques de ese tamaño con refill
+    explicit MappedInput(const char* path = nullptr, size_t streamBuffer = 0);
+    MappedInput(const MappedInput&) = delete;
+    MappedInput& operator=(const MappedInput&) = delete;
+    ~MappedInput();
+
+    const char* begin() const { return mapped ? static_cast<const char*>(mapped) : buffer.data(); }
+    const char* end() const { return begin() + length; }
+    size_t size() const { return length; }
+
+    bool streaming() const { return streamed; }
+    // Mueve [keep, end()) al inicio del buffer y lee el siguiente bloque; falso si ya no hay más entrada
+    bool refill(const char* keep);
+
+private:
+    int fd;
+    void* mapped;
+    size_t length;
+    std::vector<char> buffer;  // Solo si la entrada no se puede mapear
+    bool streamed;
+};
+
+class NumberReader {
+public:
+    NumberReader(const char* begin, const char* end, bool binary)
+        : source(nullptr), cursor(begin), end(end), binary(binary) {}
+    NumberReader(MappedInput& input, bool binary)
+        : source(input.streaming() ? &input : nullptr), cursor(input.begin()), end(input.end()), binary(binary) {}
+
+    bool readCount(size_t& count);
+    size_t read(double* out, size_t max);
+
+private:
+    static bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+    bool refill();
+    void skipSpaces();
+    void completeToken();
+
+    MappedInput* source;  // Solo si la entrada se lee por bloques
+    const char* cursor;
+    const char* end;
+    bool binary;
+};
+
+class BufferedWriter {
+public:
+    explicit BufferedWriter(std::FILE* out, size_t capacity = 1 << 20) : out(out), buffer(capacity), used(0) {}
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+    // El destructor no puede lanzar: quien necesite saber si la salida se escribió debe llamar flush()
+    ~BufferedWriter() {
+        try {
+            flush();
+        } catch (const std::runtime_error&) {
+        }
+    }
+
+    // Lanzan std::runtime_error si fwrite escribe menos de lo pedido o fflush falla
+    void write(std::string_view text);
+    void write(double value);
+    void flush();
+
+private:
+    // Con %g y 6 dígitos significativos un double ocupa a lo más 13 caracteres (-1.23457e+308)
+    static constexpr size_t MAX_NUMBER_CHARS = 32;
+
+    std::FILE* out;
+    std::vector<char> buffer;
+    size_t used;
+};
+
+// Implementación
+
+// Complejidad: O(1) si se puede mapear o se lee por bloques; O(n) si hay que leer una tubería completa
+inline MappedInput::MappedInput(const char* path, size_t streamBuffer)
+    : fd(0), mapped(nullptr), length(0), streamed(false) {
+    if (path) {
+        fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error(std::string("No se pudo abrir ") + path);
+        }
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        length = static_cast<size_t>(info.st_size);
+        mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            mapped = nullptr;
+            length = 0;
+        } else {
+            ::madvise(mapped, length, MADV_SEQUENTIAL);
+            return;
+        }
+    }
+
+    if (streamBuffer > 0) {
+        streamed = true;
+        buffer.resize(streamBuffer);
+        refill(begin());
+        return;
+    }
+
+    // Tubería o archivo que no se pudo mapear: se lee completo
+    char chunk[1 << 16];
+    ssize_t read;
+    while ((read = ::read(fd, chunk, sizeof(chunk))) > 0) {
+        buffer.insert(buffer.end(), chunk, chunk + read);
+    }
+    length = buffer.size();
+}
+
+// Complejidad: O(k) para un bloque de k bytes
+inline bool MappedInput::refill(const char* keep) {
+    size_t kept = static_cast<size_t>(end() - keep);
+    std::memmove(buffer.data(), keep, kept);
+    if (kept == buffer.size()) {
+        buffer.resize(2 * buffer.size());  // Un solo número más largo que el buffer
+    }
+    ssize_t read;
+    do {
+        read = ::read(fd, buffer.data() + kept, buffer.size() - kept);
+    } while (read < 0 && errno == EINTR);
+    length = kept + static_cast<size_t>(std::max<ssize_t>(read, 0));
+    return read > 0;
+}
+
+inline MappedInput::~MappedInput() {
+    if (mapped) {
+        ::munmap(mapped, length);
+    }
+    if (fd > 0) {
+        ::close(fd);
+    }
+}
+
+inline bool NumberReader::refill() {
+    if (!source || !source->refill(cursor)) {
+        return false;
+    }
+    cursor = source->begin();
+    end = source->end();
+    return true;
+}
+
+inline void NumberReader::skipSpaces() {
+    do {
+        while (cursor < end && isSpace(*cursor)) {
+            ++cursor;
+        }
+    } while (cursor == end && refill());
+}
+
+// Leyendo por bloques, rellena el buffer hasta que el número que empieza en cursor termine dentro de él
+inline void NumberReader::completeToken() {
+    if (!source) {
+        return;
+    }
+    size_t length = 0;
+    do {
+        while (cursor + length < end && !isSpace(cursor[length])) {
+            ++length;
+        }
+    } while (cursor + length == end && refill());
+}
+
+// Texto: lee el entero inicial N. Binario: N es el número de doubles completos (o el máximo si se lee por
+// bloques, y entonces read se detiene al final de la entrada)
+// Complejidad: O(1)
+inline bool NumberReader::readCount(size_t& count) {
+    if (binary) {
+        count = source ? SIZE_MAX : static_cast<size_t>(end - cursor) / sizeof(double);
+        return true;
+    }
+    skipSpaces();
+    completeToken();
+    auto [next, error] = std::from_chars(cursor, end, count);
+    if (error != std::errc()) {
+        return false;
+    }
+    cursor = next;
+    return true;
+}
+
+// Lee hasta max valores en out y devuelve cuántos leyó (menos de max solo si se acabó la entrada)
+// Complejidad: O(k) para k valores
+inline size_t NumberReader::read(double* out, size_t max) {
+    if (binary) {
+        size_t count = 0;
+        do {
+            size_t available = std::min(max - count, static_cast<size_t>(end - cursor) / sizeof(double));
+            std::memcpy(out + count, cursor, available * sizeof(double));
+            cursor += available * sizeof(double);
+            count += available;
+        } while (count < max && refill());
+        if constexpr (std::endian::native == std::endian::big) {
+            for (size_t i = 0; i < count; ++i) {
+                out[i] = std::bit_cast<double>(__builtin_bswap64(std::bit_cast<uint64_t>(out[i])));
+            }
+        }
+        return count;
+    }
+
+    size_t count = 0;
+    while (count < max) {
+        skipSpaces();
+        completeToken();
+        if (cursor >= end) {
+            break;
+        }
+        auto [next, error] = std::from_chars(cursor, end, out[count]);
+        if (error != std::errc()) {
+            // Camino lento: strtod necesita una cadena terminada en '\0'
+            const char* token = cursor;
+            while (cursor < end && !isSpace(*cursor)) {
+                ++cursor;
+            }
+            std::string text(token, cursor);
+            char* parsedEnd;
+            out[count] = std::strtod(text.c_str(), &parsedEnd);
+            if (parsedEnd == text.c_str()) {
+                break;
+            }
+        } else {
+            cursor = next;
+        }
+        ++count;
+    }
+    return count;
+}
+
+// Complejidad: O(k) amortizado para k caracteres
+inline void BufferedWriter::write(std::string_view text) {
+    if (used + text.size() > buffer.size()) {
+        flush();
+        if (text.size() > buffer.size()) {
+            if (std::fwrite(text.data(), 1, text.size(), out) != text.size()) {
+                throw std::runtime_error("No se pudo escribir la salida");
+            }
+            return;
+        }
+    }
+    std::memcpy(buffer.data() + used, text.data(), text.size());
+    used += text.size();
+}
+
+// Complejidad: O(1) amortizado
+inline void BufferedWriter::write(double value) {
+    if (used + MAX_NUMBER_CHARS > buffer.size()) {
+        flush();
+    }
+    char* begin = buffer.data() + used;
+    used = std::to_chars(begin, buffer.data() + buffer.size(), value, std::chars_format::general, 6).ptr - buffer.data();
+}
+
+inline void BufferedWriter::flush() {
+    size_t pending = used;
+    used = 0;
+    if ((pending > 0 && std::fwrite(buffer.data(), 1, pending, out) != pending) || std::fflush(out) != 0) {
+        throw std::runtime_error("No se pudo escribir la salida");
+    }
+}
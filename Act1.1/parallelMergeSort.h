@@ -0,0 +1,146 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstddef>
+
+/*
+    * Merge Sort paralelo para std::vector<double> con fork/join por tareas.
+    *
+    * - Un solo buffer auxiliar del tamaño del arreglo, reservado al inicio. Los dos arreglos se turnan como
+    *   origen y destino en cada nivel (ping-pong), así merge ya no reserva memoria en cada llamada.
+    * - Los rangos de PARALLEL_INSERTION_THRESHOLD elementos o menos se ordenan por inserción.
+    * - Mientras queden hilos disponibles, cada división lanza la mitad izquierda en un hilo nuevo y resuelve
+    *   la derecha en el actual (fork/join); el presupuesto de hilos se reparte entre las dos mitades.
+    * - En esos mismos niveles la mezcla también es paralela: la salida se divide en tramos iguales y cada hilo
+    *   encuentra con búsqueda binaria sobre el camino de mezcla (merge path) cuántos elementos de cada mitad le
+    *   tocan, sin comunicarse con los demás.
+    *
+    * El resultado es estable y el mismo que el de mergeSort para cualquier número de hilos.
+*/
+
+const size_t PARALLEL_INSERTION_THRESHOLD = 32;
+
+void parallelMergeSort(std::vector<double>& arr, unsigned threads = std::thread::hardware_concurrency());
+
+// Implementación
+
+/**
+ * Ordena por inserción arr[left, right)
+ * Complejidad Temporal: O(k^2) con k = right - left, que está acotado por PARALLEL_INSERTION_THRESHOLD
+ */
+inline void insertionSortRange(double* arr, size_t left, size_t right) {
+    for (size_t i = left + 1; i < right; ++i) {
+        double value = arr[i];
+        size_t j = i;
+        while (j > left && arr[j - 1] > value) {
+            arr[j] = arr[j - 1];
+            --j;
+        }
+        arr[j] = value;
+    }
+}
+
+/**
+ * Mezcla secuencial de a[0, na) y b[0, nb) en out; con empate toma primero de a (estable)
+ * Complejidad Temporal: O(na + nb)
+ */
+inline void mergeRuns(const double* a, size_t na, const double* b, size_t nb, double* out) {
+    size_t i = 0, j = 0;
+    while (i < na && j < nb) {
+        *out++ = b[j] < a[i] ? b[j++] : a[i++];
+    }
+    out = std::copy(a + i, a + na, out);
+    std::copy(b + j, b + nb, out);
+}
+
+/**
+ * Punto del camino de mezcla: cuántos de los primeros k elementos de la salida vienen de a
+ * Complejidad Temporal: O(log min(k, na))
+ */
+inline size_t mergePathSplit(const double* a, size_t na, const double* b, size_t nb, size_t k) {
+    size_t low = k > nb ? k - nb : 0;
+    size_t high = std::min(k, na);
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (a[middle] <= b[k - middle - 1]) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+/**
+ * Mezcla src[left, middle) y src[middle, right) en dst[left, right) repartiendo la salida entre threads hilos
+ * Complejidad Temporal: O(n / threads + log n) por hilo
+ */
+inline void parallelMerge(const double* src, double* dst, size_t left, size_t middle, size_t right, unsigned threads) {
+    const double* a = src + left;
+    const double* b = src + middle;
+    size_t na = middle - left, nb = right - middle, n = na + nb;
+
+    auto mergeSegment = [&](unsigned t) {
+        size_t begin = n * t / threads, end = n * (t + 1) / threads;
+        size_t i = mergePathSplit(a, na, b, nb, begin);
+        size_t iEnd = mergePathSplit(a, na, b, nb, end);
+        mergeRuns(a + i, iEnd - i, b + (begin - i), (end - iEnd) - (begin - i), dst + left + begin);
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; ++t) {
+        workers.emplace_back(mergeSegment, t);
+    }
+    mergeSegment(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * Ordena dst[left, right) tomando como entrada el mismo rango, con src como espacio auxiliar.
+ * Al inicio ambos arreglos tienen los mismos datos en el rango: cada mitad se ordena con los papeles
+ * invertidos (quedando en src) y después se mezcla de src a dst.
+ * Complejidad Temporal: O(n log n / threads + n) con threads hilos
+ */
+inline void parallelSortInto(double* src, double* dst, size_t left, size_t right, unsigned threads) {
+    if (right - left <= PARALLEL_INSERTION_THRESHOLD) {
+        insertionSortRange(dst, left, right);
+        return;
+    }
+
+    size_t middle = left + (right - left) / 2;
+    if (threads > 1) {
+        unsigned leftThreads = threads / 2;
+        std::thread forked(parallelSortInto, dst, src, left, middle, leftThreads);
+        parallelSortInto(dst, src, middle, right, threads - leftThreads);
+        forked.join();
+    } else {
+        parallelSortInto(dst, src, left, middle, 1);
+        parallelSortInto(dst, src, middle, right, 1);
+    }
+
+    // Si las mitades ya están en orden basta con copiarlas
+    if (src[middle - 1] <= src[middle]) {
+        std::copy(src + left, src + right, dst + left);
+    } else if (threads > 1) {
+        parallelMerge(src, dst, left, middle, right, threads);
+    } else {
+        mergeRuns(src + left, middle - left, src + middle, right - middle, dst + left);
+    }
+}
+
+/**
+ * Merge Sort paralelo con buffer ping-pong
+ * Complejidad Temporal: O(n log n / p + n) con p hilos
+ * Complejidad Espacial: O(n), un solo buffer auxiliar
+ */
+inline void parallelMergeSort(std::vector<double>& arr, unsigned threads) {
+    if (arr.size() < 2) {
+        return;
+    }
+    std::vector<double> buffer(arr);
+    parallelSortInto(buffer.data(), arr.data(), 0, arr.size(), std::max(1u, threads));
+}
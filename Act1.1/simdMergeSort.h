@@ -0,0 +1,302 @@
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cstddef>
+#include <cmath>
+#include "mergeSort.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SIMD_MERGE_SORT_X86 1
+#endif
+
+/*
+    * Merge Sort vectorizado para std::vector<double>.
+    *
+    * El while escalar de merge hace una comparación impredecible por elemento. Aquí las comparaciones se hacen
+    * con min/max sobre registros completos, sin saltos:
+    * - Fase de bloques: cada bloque de 16 valores se carga en 4 registros AVX2 (4 doubles cada uno). Una red de
+    *   ordenamiento ordena las columnas, una transposición 4x4 deja cada registro ordenado y dos rondas de
+    *   mezcla bitónica producen el bloque de 16 ordenado.
+    * - Fase de mezcla: pasadas ascendentes como en bottomUpMergeSort. Cada mezcla avanza W elementos a la vez
+    *   (W = 4 con AVX2, 8 con AVX-512) con una red bitónica de 2W entradas dentro de los registros; solo queda
+    *   un salto por cada W elementos para elegir de qué corrida se carga el siguiente registro.
+    *
+    * La entrada se rellena con +infinito hasta un múltiplo de 16, así todas las corridas son múltiplos de W.
+    * El nivel se elige en tiempo de ejecución con detectSimdLevel(); sin AVX2 (u otra arquitectura) se usa
+    * bottomUpMergeSort. Un nivel pedido mayor que el que soporta el procesador se baja al detectado.
+    *
+    * min/max de AVX devuelven el segundo operando si uno es NaN, así que un NaN dentro de la red duplicaría
+    * unos valores y perdería otros. Antes de ordenar los NaN se apartan y al final quedan en la cola del
+    * arreglo (en cualquier orden entre ellos). Con valores iguales devuelven también el segundo operando, y
+    * como -0.0 == +0.0 la red podría duplicar un signo de cero y perder el otro: los ceros también se
+    * apartan y se reinsertan en su lugar, primero los -0.0 y luego los +0.0. Así el resultado es siempre
+    * una permutación bit a bit de la entrada.
+*/
+
+enum class SimdLevel { Scalar, AVX2, AVX512 };
+
+SimdLevel detectSimdLevel();
+const char* simdLevelName(SimdLevel level);
+void simdMergeSort(std::vector<double>& arr, SimdLevel level = detectSimdLevel());
+
+// Implementación
+
+inline SimdLevel detectSimdLevel() {
+#ifdef SIMD_MERGE_SORT_X86
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX512: return "AVX-512";
+        case SimdLevel::AVX2: return "AVX2";
+        default: return "escalar";
+    }
+}
+
+#ifdef SIMD_MERGE_SORT_X86
+
+// GCC 12 avisa "__Y is used uninitialized" dentro de los intrínsecos de AVX-512 (falso positivo de sus headers)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+
+#define SIMD_AVX2 __attribute__((target("avx2")))
+#define SIMD_AVX512 __attribute__((target("avx512f")))
+
+/**
+ * Ordena un registro bitónico de 4 valores: compara a distancia 2 y después a distancia 1
+ * Complejidad Temporal: O(1), 2 etapas de min/max
+ */
+SIMD_AVX2 inline __m256d bitonicSort4(__m256d v) {
+    __m256d swapped = _mm256_permute4x64_pd(v, 0x4E);  // (2, 3, 0, 1)
+    v = _mm256_blend_pd(_mm256_min_pd(v, swapped), _mm256_max_pd(v, swapped), 0xC);
+    swapped = _mm256_permute_pd(v, 0x5);                // (1, 0, 3, 2)
+    return _mm256_blend_pd(_mm256_min_pd(v, swapped), _mm256_max_pd(v, swapped), 0xA);
+}
+
+/**
+ * Mezcla dos registros ordenados: al terminar low tiene los 4 menores y high los 4 mayores, ambos ordenados
+ * Complejidad Temporal: O(1)
+ */
+SIMD_AVX2 inline void bitonicMerge4(__m256d& low, __m256d& high) {
+    __m256d reversed = _mm256_permute4x64_pd(high, 0x1B);  // (3, 2, 1, 0)
+    __m256d minimum = _mm256_min_pd(low, reversed);
+    __m256d maximum = _mm256_max_pd(low, reversed);
+    low = bitonicSort4(minimum);
+    high = bitonicSort4(maximum);
+}
+
+// Deja en a el mínimo y en b el máximo de cada posición
+SIMD_AVX2 inline void compareExchange(__m256d& a, __m256d& b) {
+    __m256d minimum = _mm256_min_pd(a, b);
+    b = _mm256_max_pd(a, b);
+    a = minimum;
+}
+
+/**
+ * Ordena 16 valores en su lugar con una red de ordenamiento de 4 registros
+ * Complejidad Temporal: O(1)
+ */
+SIMD_AVX2 inline void sortBlock16(double* block) {
+    __m256d r0 = _mm256_loadu_pd(block), r1 = _mm256_loadu_pd(block + 4);
+    __m256d r2 = _mm256_loadu_pd(block + 8), r3 = _mm256_loadu_pd(block + 12);
+
+    // Red de 4 entradas por columnas: (0,1) (2,3) (0,2) (1,3) (1,2)
+    compareExchange(r0, r1);
+    compareExchange(r2, r3);
+    compareExchange(r0, r2);
+    compareExchange(r1, r3);
+    compareExchange(r1, r2);
+
+    // Transposición 4x4: cada columna ordenada pasa a ser un registro
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1);
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+    r0 = _mm256_permute2f128_pd(t0, t2, 0x20);
+    r1 = _mm256_permute2f128_pd(t1, t3, 0x20);
+    r2 = _mm256_permute2f128_pd(t0, t2, 0x31);
+    r3 = _mm256_permute2f128_pd(t1, t3, 0x31);
+
+    // Corridas de 4 -> corridas de 8
+    bitonicMerge4(r0, r1);
+    bitonicMerge4(r2, r3);
+
+    // Corridas de 8 -> 16: (r0, r1) contra (r2, r3) invertida; después cada mitad es bitónica de 8
+    __m256d reversed2 = _mm256_permute4x64_pd(r3, 0x1B), reversed3 = _mm256_permute4x64_pd(r2, 0x1B);
+    __m256d low0 = _mm256_min_pd(r0, reversed2), high0 = _mm256_max_pd(r0, reversed2);
+    __m256d low1 = _mm256_min_pd(r1, reversed3), high1 = _mm256_max_pd(r1, reversed3);
+    compareExchange(low0, low1);
+    compareExchange(high0, high1);
+
+    _mm256_storeu_pd(block, bitonicSort4(low0));
+    _mm256_storeu_pd(block + 4, bitonicSort4(low1));
+    _mm256_storeu_pd(block + 8, bitonicSort4(high0));
+    _mm256_storeu_pd(block + 12, bitonicSort4(high1));
+}
+
+/**
+ * Mezcla a[0, na) y b[0, nb) en out, 4 valores por iteración. na y nb son múltiplos de 4 y mayores que 0
+ * Complejidad Temporal: O(na + nb)
+ */
+SIMD_AVX2 inline void mergeRunsAVX2(const double* a, size_t na, const double* b, size_t nb, double* out) {
+    __m256d low = _mm256_loadu_pd(a), high = _mm256_loadu_pd(b);
+    size_t i = 4, j = 4;
+    while (true) {
+        bitonicMerge4(low, high);
+        _mm256_storeu_pd(out, low);
+        out += 4;
+        // El siguiente registro viene de la corrida cuyo próximo valor es menor
+        if (i < na && (j >= nb || a[i] <= b[j])) {
+            low = _mm256_loadu_pd(a + i);
+            i += 4;
+        } else if (j < nb) {
+            low = _mm256_loadu_pd(b + j);
+            j += 4;
+        } else {
+            break;
+        }
+    }
+    _mm256_storeu_pd(out, high);
+}
+
+/**
+ * Igual que bitonicSort4 con registros de 8 valores: etapas a distancia 4, 2 y 1
+ * Complejidad Temporal: O(1)
+ */
+SIMD_AVX512 inline __m512d bitonicSort8(__m512d v) {
+    __m512d swapped = _mm512_shuffle_f64x2(v, v, 0x4E);   // Intercambia las mitades de 256 bits
+    v = _mm512_mask_blend_pd(0xF0, _mm512_min_pd(v, swapped), _mm512_max_pd(v, swapped));
+    swapped = _mm512_permutex_pd(v, 0x4E);                 // (2, 3, 0, 1) en cada mitad
+    v = _mm512_mask_blend_pd(0xCC, _mm512_min_pd(v, swapped), _mm512_max_pd(v, swapped));
+    swapped = _mm512_permute_pd(v, 0x55);                  // (1, 0) en cada par
+    return _mm512_mask_blend_pd(0xAA, _mm512_min_pd(v, swapped), _mm512_max_pd(v, swapped));
+}
+
+/**
+ * Igual que bitonicMerge4 con registros de 8 valores
+ * Complejidad Temporal: O(1)
+ */
+SIMD_AVX512 inline void bitonicMerge8(__m512d& low, __m512d& high) {
+    // Invierte el orden de los pares de 128 bits y después cada par
+    __m512d reversed = _mm512_permute_pd(_mm512_shuffle_f64x2(high, high, 0x1B), 0x55);
+    __m512d minimum = _mm512_min_pd(low, reversed);
+    __m512d maximum = _mm512_max_pd(low, reversed);
+    low = bitonicSort8(minimum);
+    high = bitonicSort8(maximum);
+}
+
+/**
+ * Igual que mergeRunsAVX2 con 8 valores por iteración. na y nb son múltiplos de 8 y mayores que 0
+ * Complejidad Temporal: O(na + nb)
+ */
+SIMD_AVX512 inline void mergeRunsAVX512(const double* a, size_t na, const double* b, size_t nb, double* out) {
+    __m512d low = _mm512_loadu_pd(a), high = _mm512_loadu_pd(b);
+    size_t i = 8, j = 8;
+    while (true) {
+        bitonicMerge8(low, high);
+        _mm512_storeu_pd(out, low);
+        out += 8;
+        if (i < na && (j >= nb || a[i] <= b[j])) {
+            low = _mm512_loadu_pd(a + i);
+            i += 8;
+        } else if (j < nb) {
+            low = _mm512_loadu_pd(b + j);
+            j += 8;
+        } else {
+            break;
+        }
+    }
+    _mm512_storeu_pd(out, high);
+}
+
+#undef SIMD_AVX2
+#undef SIMD_AVX512
+#pragma GCC diagnostic pop
+
+#endif
+
+/**
+ * Ordena arr, que no tiene NaN, con el nivel indicado (bottomUpMergeSort si es Scalar)
+ * Complejidad Temporal: O(n log n)
+ * Complejidad Espacial: O(n), un buffer auxiliar más el relleno hasta un múltiplo de 16
+ */
+inline void simdMergeSortNumbers(std::vector<double>& arr, SimdLevel level) {
+    size_t n = arr.size();
+#ifdef SIMD_MERGE_SORT_X86
+    if (level != SimdLevel::Scalar && n >= 2) {
+        const size_t BLOCK = 16;
+        size_t padded = (n + BLOCK - 1) / BLOCK * BLOCK;
+        arr.resize(padded, std::numeric_limits<double>::infinity());
+        std::vector<double> buffer(padded);
+
+        for (size_t left = 0; left < padded; left += BLOCK) {
+            sortBlock16(arr.data() + left);
+        }
+
+        double* src = arr.data();
+        double* dst = buffer.data();
+        for (size_t width = BLOCK; width < padded; width *= 2) {
+            for (size_t left = 0; left < padded; left += 2 * width) {
+                size_t middle = std::min(left + width, padded);
+                size_t right = std::min(left + 2 * width, padded);
+                if (middle == right || src[middle - 1] <= src[middle]) {
+                    std::copy(src + left, src + right, dst + left);
+                } else if (level == SimdLevel::AVX512) {
+                    mergeRunsAVX512(src + left, middle - left, src + middle, right - middle, dst + left);
+                } else {
+                    mergeRunsAVX2(src + left, middle - left, src + middle, right - middle, dst + left);
+                }
+            }
+            std::swap(src, dst);
+        }
+
+        if (src != arr.data()) {
+            std::copy(src, src + n, arr.data());
+        }
+        arr.resize(n);
+        return;
+    }
+#endif
+    (void)level;
+    bottomUpMergeSort(arr.begin(), arr.end());
+}
+
+/**
+ * Merge Sort vectorizado con el nivel de instrucciones indicado, sin pasar del que soporta el procesador
+ * Complejidad Temporal: O(n log n)
+ * Complejidad Espacial: O(n), más una copia de los NaN si los hay
+ */
+inline void simdMergeSort(std::vector<double>& arr, SimdLevel level) {
+    auto numbersEnd = std::partition(arr.begin(), arr.end(), [](double value) { return !std::isnan(value); });
+    std::vector<double> nans(numbersEnd, arr.end());
+    arr.erase(numbersEnd, arr.end());
+
+    size_t negativeZeros = 0;
+    size_t positiveZeros = 0;
+    for (double value : arr) {
+        if (value == 0.0) {
+            ++(std::signbit(value) ? negativeZeros : positiveZeros);
+        }
+    }
+    if (negativeZeros + positiveZeros > 0) {
+        arr.erase(std::remove(arr.begin(), arr.end(), 0.0), arr.end());
+    }
+
+    simdMergeSortNumbers(arr, std::min(level, detectSimdLevel()));
+
+    if (negativeZeros + positiveZeros > 0) {
+        auto zerosAt = std::lower_bound(arr.begin(), arr.end(), 0.0);
+        zerosAt = arr.insert(zerosAt, positiveZeros, 0.0);
+        arr.insert(zerosAt, negativeZeros, -0.0);
+    }
+    arr.insert(arr.end(), nans.begin(), nans.end());
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+#include "changeDP.h"
+
+/*
+    * Simulador de caja con estado: el suministro ya no se restaura después de cada consulta.
+    * Cada transacción agrega a la caja las monedas del pago, calcula el cambio óptimo con el suministro
+    * resultante y lo descuenta. Si no hay cambio posible (o el pago no alcanza) la transacción se rechaza
+    * y la caja queda como estaba.
+    *
+    * Las tablas de ChangeDP se construyen una vez hasta maxChangeCents y después solo se recalculan las
+    * capas de las denominaciones cuyo suministro cambió (ver ChangeDP::setSupply). Con incremental = false
+    * se reconstruyen completas en cada transacción, como referencia para el benchmark de reproducción.
+*/
+class CashDrawer {
+public:
+    CashDrawer(const std::vector<double>& denominations, const std::vector<int>& supply,
+               long long maxChangeCents, bool incremental = true);
+
+    bool transaction(long long priceCents, const std::vector<int>& payment, std::vector<int>& change);
+    const std::vector<int>& getSupply() const { return engine.getSupply(); }
+    long long getAccepted() const { return accepted; }
+    long long getRejected() const { return rejected; }
+    long long getLayersRebuilt() const { return engine.getLayersRebuilt(); }
+
+private:
+    void apply(const std::vector<int>& counts, int sign);
+
+    ChangeDP engine;
+    std::vector<long long> cents;    // Denominaciones en centavos, en el orden de entrada
+    bool incremental;
+    long long accepted;
+    long long rejected;
+};
+
+// Implementación
+
+// Complejidad: O(N * A) por la construcción inicial de las tablas
+inline CashDrawer::CashDrawer(const std::vector<double>& denominations, const std::vector<int>& supply,
+                              long long maxChangeCents, bool incremental)
+    : engine(denominations, supply), incremental(incremental), accepted(0), rejected(0) {
+    for (double denomination : denominations) {
+        cents.push_back(ChangeDP::toCents(denomination));
+    }
+    engine.build(maxChangeCents);
+}
+
+// Suma (sign = 1) o resta (sign = -1) monedas a la caja
+// Complejidad: O(N)
+inline void CashDrawer::apply(const std::vector<int>& counts, int sign) {
+    for (size_t i = 0; i < cents.size(); ++i) {
+        if (counts[i] != 0) {
+            engine.addSupply(i, sign * counts[i]);
+        }
+    }
+}
+
+// Registra una venta de priceCents pagada con payment[i] monedas de cada denominación.
+// Devuelve false si se rechaza; en ese caso el suministro no cambia
+// Complejidad: O(N) más el recálculo de las capas invalidadas, O((N - capa) * A) en el peor caso
+inline bool CashDrawer::transaction(long long priceCents, const std::vector<int>& payment, std::vector<int>& change) {
+    long long paid = 0;
+    for (size_t i = 0; i < cents.size(); ++i) {
+        paid += payment[i] * cents[i];
+    }
+    if (paid < priceCents) {
+        change.assign(cents.size(), 0);
+        rejected++;
+        return false;
+    }
+
+    // El pago entra a la caja antes de dar el cambio, así sus monedas también pueden devolverse
+    apply(payment, 1);
+    if (!incremental) {
+        engine.build(engine.getMaxCents());
+    }
+    if (!engine.solveCents(paid - priceCents, change)) {
+        apply(payment, -1);
+        rejected++;
+        return false;
+    }
+    apply(change, -1);
+    accepted++;
+    return true;
+}
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <climits>
+#include <cmath>
+#include <stdexcept>
+
+/*
+    * Motor de programación dinámica ascendente para el problema del cambio con suministro limitado
+    * (mochila acotada). Trabaja con centavos enteros y arreglos planos: no hay recursión, ni redondeos
+    * de punto flotante, ni claves de texto por subproblema.
+    *
+    * Las cantidades se expresan en unidades del máximo común divisor de las denominaciones (en centavos),
+    * así con {1000, ..., 1, 0.5} una unidad vale 50 centavos y las tablas son 50 veces más pequeñas.
+    *
+    * Cada denominación es una capa: minCoins[a] = min_{0 <= k <= supply} (minCoins_anterior[a - k*d] + k).
+    * Para no probar las k posibles de cada cantidad, se recorre cada clase de residuo módulo d con una cola
+    * monótona (mínimo de ventana deslizante), lo que deja cada capa en O(A).
+    * Por cada capa se guarda cuántas monedas de esa denominación usa la mejor solución de cada cantidad,
+    * así reconstruir una respuesta cuesta O(N).
+    *
+    * Resultado: mínimo número de monedas respetando el suministro. Entre soluciones con el mismo número de
+    * monedas se prefieren menos monedas de las denominaciones chicas (la reconstrucción empieza por la capa de
+    * la más chica), lo que deja cambio chico en la caja.
+    *
+    * Se conserva la tabla de mínimos de cada capa, así cambiar el suministro de una denominación (setSupply)
+    * solo invalida su capa y las siguientes; la siguiente consulta recalcula desde la capa más baja invalidada.
+    * Las capas van de la denominación más grande a la más chica: en una caja las monedas chicas son las que
+    * cambian en casi todas las transacciones, y así sus capas son las últimas y las que menos recalculan.
+    * Si el límite efectivo min(suministro, A / d) no cambia, la capa sigue siendo válida y no se recalcula nada.
+    *
+    * Las denominaciones deben ser positivas (una de 0 centavos no cubre ninguna cantidad).
+*/
+class ChangeDP {
+public:
+    ChangeDP(const std::vector<double>& denominations, const std::vector<int>& supply);
+
+    void build(long long maxCents);
+    bool solveCents(long long cents, std::vector<int>& counts);
+    std::vector<int> solve(double change);
+    void setSupply(int i, int count);
+    void addSupply(int i, int delta) { setSupply(i, supply[i] + delta); }
+    const std::vector<int>& getSupply() const { return supply; }
+    long long getLayersRebuilt() const { return layersRebuilt; }
+    long long getMaxCents() const { return maxUnits * unit; }
+    long long getUnit() const { return unit; }
+
+    static long long toCents(double amount) { return std::llround(amount * 100.0); }
+
+private:
+    static constexpr int INFEASIBLE = INT_MAX;
+
+    void buildLayers(int from);
+    long long effectiveLimit(int i) const { return std::min<long long>(std::max(0, supply[i]), maxUnits / std::max(1LL, cents[i] / unit)); }
+
+    std::vector<long long> cents;    // Denominaciones en centavos, en el orden de entrada
+    std::vector<int> supply;
+    std::vector<int> order;          // Índices de denominación de mayor a menor: orden de las capas
+    std::vector<int> layerOf;        // Inverso de order: capa de cada denominación
+    long long unit;                  // Máximo común divisor de las denominaciones en centavos
+    long long maxUnits;              // Cantidad más grande que cubren las tablas
+    bool built;
+    int dirtyLayer;                  // Primera capa que no refleja el suministro actual (N si todas son válidas)
+    long long layersRebuilt;         // Capas recalculadas desde la construcción, para medir las actualizaciones
+
+    std::vector<int> minCoins;       // minCoins[(capa + 1) * (maxUnits + 1) + a]: mínimo de monedas con las capas
+                                     // 0..capa para a unidades, o INFEASIBLE; la fila 0 es la base sin monedas
+    std::vector<int> take;           // take[capa * (maxUnits + 1) + a]: monedas de esa capa en la solución de a
+    std::vector<long long> window;   // Cola monótona: posiciones t dentro de una clase de residuo
+};
+
+// Implementación
+
+// Lanza std::invalid_argument si alguna denominación no es positiva en centavos
+// Complejidad: O(N log N) por ordenar las denominaciones
+inline ChangeDP::ChangeDP(const std::vector<double>& denominations, const std::vector<int>& supply)
+    : supply(supply), unit(0), maxUnits(0), built(false), dirtyLayer(0), layersRebuilt(0) {
+    int N = denominations.size();
+    cents.resize(N);
+    order.resize(N);
+    layerOf.resize(N);
+    for (int i = 0; i < N; ++i) {
+        cents[i] = toCents(denominations[i]);
+        if (cents[i] <= 0) {
+            throw std::invalid_argument("ChangeDP: las denominaciones deben ser de al menos un centavo");
+        }
+        unit = std::gcd(unit, cents[i]);
+        order[i] = i;
+    }
+    if (unit == 0) {
+        unit = 1;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return cents[a] > cents[b]; });
+    for (int layer = 0; layer < N; ++layer) {
+        layerOf[order[layer]] = layer;
+    }
+}
+
+// Construye las tablas para todas las cantidades de 0 a maxCents
+// Complejidad: O(N * A) en tiempo y espacio, donde A = maxCents / unidad
+inline void ChangeDP::build(long long maxCents) {
+    int N = cents.size();
+    maxUnits = std::max(0LL, maxCents / unit);
+    size_t width = static_cast<size_t>(maxUnits) + 1;
+
+    minCoins.assign(static_cast<size_t>(N + 1) * width, INFEASIBLE);
+    take.assign(static_cast<size_t>(N) * width, 0);
+    window.resize(width);
+    minCoins[0] = 0;
+
+    buildLayers(0);
+    built = true;
+}
+
+// Recalcula las capas from..N-1 a partir de la tabla de la capa anterior, que sigue siendo válida
+// Complejidad: O((N - from) * A)
+inline void ChangeDP::buildLayers(int from) {
+    int N = cents.size();
+    size_t width = static_cast<size_t>(maxUnits) + 1;
+
+    for (int layer = from; layer < N; ++layer) {
+        int i = order[layer];
+        long long d = cents[i] / unit;
+        long long limit = effectiveLimit(i);
+        const int* previous = &minCoins[static_cast<size_t>(layer) * width];
+        int* current = &minCoins[static_cast<size_t>(layer + 1) * width];
+        int* layerTake = &take[static_cast<size_t>(layer) * width];
+
+        // Las cantidades a = r + t*d de un mismo residuo r forman una secuencia; para cada t la mejor
+        // opción es el mínimo de previous[r + t'*d] - t' con t - limit <= t' <= t, más t
+        for (long long r = 0; r < d && r <= maxUnits; ++r) {
+            size_t head = 0, tail = 0;
+            for (long long t = 0, a = r; a <= maxUnits; ++t, a += d) {
+                if (previous[a] != INFEASIBLE) {
+                    long long key = previous[a] - t;
+                    // Con empate se conserva la posición más reciente: menos monedas de esta denominación
+                    while (tail > head && previous[r + window[tail - 1] * d] - window[tail - 1] >= key) {
+                        tail--;
+                    }
+                    window[tail++] = t;
+                }
+                while (tail > head && window[head] < t - limit) {
+                    head++;
+                }
+
+                if (tail > head) {
+                    long long best = window[head];
+                    current[a] = static_cast<int>(previous[r + best * d] - best + t);
+                    layerTake[a] = static_cast<int>(t - best);
+                } else {
+                    current[a] = INFEASIBLE;
+                    layerTake[a] = 0;
+                }
+            }
+        }
+    }
+    layersRebuilt += N - from;
+    dirtyLayer = N;
+}
+
+// Cambia el suministro de la denominación i. Solo invalida su capa (y las siguientes) si cambia el número
+// de monedas que las tablas pueden usar; el recálculo se hace en la siguiente consulta
+// Complejidad: O(1)
+inline void ChangeDP::setSupply(int i, int count) {
+    long long before = effectiveLimit(i);
+    supply[i] = count;
+    if (built && effectiveLimit(i) != before) {
+        dirtyLayer = std::min(dirtyLayer, layerOf[i]);
+    }
+}
+
+// Reconstruye la solución de una cantidad en centavos; construye (o amplía) las tablas si hace falta
+// y recalcula las capas invalidadas por setSupply
+// Complejidad: O(N) si las tablas ya cubren la cantidad y están al día
+inline bool ChangeDP::solveCents(long long amount, std::vector<int>& counts) {
+    int N = cents.size();
+    counts.assign(N, 0);
+    if (amount < 0 || amount % unit != 0) {
+        return false;
+    }
+    long long a = amount / unit;
+    if (!built || a > maxUnits) {
+        build(amount);
+    } else if (dirtyLayer < N) {
+        buildLayers(dirtyLayer);
+    }
+
+    size_t width = static_cast<size_t>(maxUnits) + 1;
+    if (minCoins[static_cast<size_t>(N) * width + a] == INFEASIBLE) {
+        return false;
+    }
+
+    for (int layer = N - 1; layer >= 0; --layer) {
+        int i = order[layer];
+        counts[i] = take[static_cast<size_t>(layer) * width + a];
+        a -= counts[i] * (cents[i] / unit);
+    }
+    return true;
+}
+
+// Mismo formato que calculateChange: cantidades por denominación, y result[N-1] = -1 si no hay solución
+// Complejidad: O(N) si las tablas ya cubren la cantidad
+inline std::vector<int> ChangeDP::solve(double change) {
+    std::vector<int> result;
+    if (!solveCents(toCents(change), result)) {
+        result.assign(cents.size(), 0);
+        result[cents.size() - 1] = -1;
+    }
+    return result;
+}
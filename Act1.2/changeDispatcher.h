@@ -0,0 +1,188 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include "changeDP.h"
+
+/*
+    * Despachador de consultas de cambio: decide por consulta entre el voraz O(N) y ChangeDP.
+    *
+    * Al construirse analiza una sola vez el sistema de denominaciones con suministro positivo (las demás
+    * nunca se pueden usar) con la prueba de Pearson: en O(N^3) encuentra el contraejemplo más pequeño de
+    * un sistema no canónico, o demuestra que el voraz es óptimo para toda cantidad con suministro ilimitado.
+    *
+    * Con suministro limitado la canonicidad no basta. Pero si el voraz no choca con el suministro de ninguna
+    * denominación, su respuesta es la misma que con suministro ilimitado, que es óptima sin límites y por lo
+    * tanto también con ellos. Así cada consulta usa el voraz si el sistema es canónico y ninguna denominación
+    * se agota; en otro caso se responde con ChangeDP, cuyas tablas se construyen solo cuando hace falta.
+    *
+    * Ambos caminos devuelven una solución con el mínimo de monedas. Si hay varias, el voraz elige la de más
+    * monedas grandes y ChangeDP la de menos monedas chicas, que casi siempre es la misma.
+*/
+class ChangeDispatcher {
+public:
+    ChangeDispatcher(const std::vector<double>& denominations, const std::vector<int>& supply);
+
+    void reserve(long long maxCents) { reservedCents = std::max(reservedCents, maxCents); }
+    bool solveCents(long long cents, std::vector<int>& counts);
+    std::vector<int> solve(double change);
+
+    bool isCanonical() const { return counterexample < 0; }
+    long long getCounterexampleCents() const { return counterexample < 0 ? -1 : counterexample * unit; }
+    long long getGreedyQueries() const { return greedyQueries; }
+    long long getDPQueries() const { return dpQueries; }
+
+    static long long findCounterexample(const std::vector<long long>& coins);
+
+private:
+    bool solveGreedy(long long cents, std::vector<int>& counts) const;
+
+    ChangeDP engine;
+    std::vector<long long> cents;    // Denominaciones en centavos, en el orden de entrada
+    std::vector<int> supply;
+    std::vector<int> order;          // Denominaciones con suministro positivo, de mayor a menor
+    long long unit;                  // Máximo común divisor de las denominaciones con suministro, en centavos
+    long long counterexample;        // Contraejemplo más pequeño en unidades, o -1 si el sistema es canónico
+    long long reservedCents;         // Cambio máximo esperado: tamaño de las tablas cuando se construyen
+    long long greedyQueries;
+    long long dpQueries;
+};
+
+// Implementación
+
+// Complejidad: O(N^3) por la prueba de canonicidad, u O(N * (c1 + c2)) con las dos mayores si no hay moneda de 1 unidad
+inline ChangeDispatcher::ChangeDispatcher(const std::vector<double>& denominations, const std::vector<int>& supply)
+    : engine(denominations, supply), supply(supply), unit(0), counterexample(-1), reservedCents(0),
+      greedyQueries(0), dpQueries(0) {
+    int N = denominations.size();
+    cents.resize(N);
+    for (int i = 0; i < N; ++i) {
+        cents[i] = ChangeDP::toCents(denominations[i]);
+        if (supply[i] > 0 && cents[i] > 0) {
+            order.push_back(i);
+            unit = std::gcd(unit, cents[i]);
+        }
+    }
+    if (unit == 0) {
+        unit = 1;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return cents[a] > cents[b]; });
+
+    std::vector<long long> coins;
+    for (int i : order) {
+        if (coins.empty() || coins.back() != cents[i] / unit) {
+            coins.push_back(cents[i] / unit);
+        }
+    }
+    counterexample = findCounterexample(coins);
+}
+
+// Prueba de Pearson. coins va de mayor a menor, sin repetidos. Para cada par i <= j se toma la
+// representación voraz de coins[i-1] - 1, se le suma una moneda coins[j] y se descartan las monedas menores;
+// si el voraz usa más monedas que esa representación para su valor w, w es un contraejemplo.
+// Sin moneda de 1 unidad la prueba no aplica: se busca directamente el menor monto que tiene solución pero
+// que el voraz no resuelve (le queda residuo) o resuelve con más monedas. Si existe es menor que
+// coins[0] + coins[1]: para un monto mayor, quitar la moneda más grande de una solución óptima deja un monto
+// que sí se resuelve bien y cuyo voraz empieza con coins[0].
+// Devuelve el contraejemplo más pequeño, o -1 si el sistema es canónico
+// Complejidad: O(N^3) con moneda de 1 unidad; O(N * (coins[0] + coins[1])) sin ella
+inline long long ChangeDispatcher::findCounterexample(const std::vector<long long>& coins) {
+    int n = coins.size();
+    if (n == 0) {
+        return -1;
+    }
+
+    auto greedyCoins = [&](long long amount) {
+        long long total = 0;
+        for (long long coin : coins) {
+            total += amount / coin;
+            amount %= coin;
+        }
+        return amount == 0 ? total : -1;
+    };
+
+    if (coins[n - 1] != 1) {
+        if (n == 1) {
+            return -1;
+        }
+        // fewest[w] = mínimo de monedas para w con suministro ilimitado, o -1 si no tiene solución
+        long long limit = coins[0] + coins[1];
+        std::vector<long long> fewest(limit, -1);
+        fewest[0] = 0;
+        for (long long w = 1; w < limit; ++w) {
+            for (long long coin : coins) {
+                if (coin <= w && fewest[w - coin] >= 0 && (fewest[w] < 0 || fewest[w - coin] + 1 < fewest[w])) {
+                    fewest[w] = fewest[w - coin] + 1;
+                }
+            }
+            long long greedy = greedyCoins(w);
+            if (fewest[w] >= 0 && (greedy < 0 || greedy > fewest[w])) {
+                return w;
+            }
+        }
+        return -1;
+    }
+
+    long long smallest = -1;
+    std::vector<long long> representation(n);
+    for (int i = 1; i < n; ++i) {
+        long long amount = coins[i - 1] - 1;
+        for (int k = 0; k < n; ++k) {
+            representation[k] = amount / coins[k];
+            amount %= coins[k];
+        }
+        long long value = 0, count = 0;
+        for (int j = 0; j < n; ++j) {
+            // Prefijo 0..j de la representación voraz, con una moneda más de coins[j]
+            long long candidateValue = value + (representation[j] + 1) * coins[j];
+            long long candidateCount = count + representation[j] + 1;
+            if (j >= i && greedyCoins(candidateValue) > candidateCount &&
+                (smallest < 0 || candidateValue < smallest)) {
+                smallest = candidateValue;
+            }
+            value += representation[j] * coins[j];
+            count += representation[j];
+        }
+    }
+    return smallest;
+}
+
+// Voraz sobre las denominaciones con suministro; falla si alguna se agota o si queda cambio sin cubrir
+// Complejidad: O(N)
+inline bool ChangeDispatcher::solveGreedy(long long amount, std::vector<int>& counts) const {
+    counts.assign(cents.size(), 0);
+    for (int i : order) {
+        long long count = amount / cents[i];
+        if (count > supply[i]) {
+            return false;
+        }
+        counts[i] = static_cast<int>(count);
+        amount -= count * cents[i];
+    }
+    return amount == 0;
+}
+
+// Complejidad: O(N) por el voraz; O(N * A) la primera vez que se necesita ChangeDP
+inline bool ChangeDispatcher::solveCents(long long amount, std::vector<int>& counts) {
+    if (amount >= 0 && isCanonical() && solveGreedy(amount, counts)) {
+        greedyQueries++;
+        return true;
+    }
+    dpQueries++;
+    if (amount > engine.getMaxCents() && amount <= reservedCents) {
+        engine.build(reservedCents);
+    }
+    return engine.solveCents(amount, counts);
+}
+
+// Mismo formato que ChangeDP::solve: result[N-1] = -1 si no hay solución
+// Complejidad: O(N) por el voraz; O(N * A) la primera vez que se necesita ChangeDP
+inline std::vector<int> ChangeDispatcher::solve(double change) {
+    std::vector<int> result;
+    if (!solveCents(ChangeDP::toCents(change), result)) {
+        result.assign(cents.size(), 0);
+        result[cents.size() - 1] = -1;
+    }
+    return result;
+}
@@ -2,10 +2,20 @@
     #include <vector>
     #include <algorithm>
     #include <string>
+    #include <string_view>
+    #include <cstdio>
     #include <chrono>
     #include <functional>
     #include <cmath>
-    #include "../Support/HashTable/HashTable.h"
+    #include <random>
+    #include <charconv>
+    #include <cstring>
+    #include <system_error>
+    #include <optional>
+    #include "../Support/HashTable/ClockCache.h"
+    #include "changeDP.h"
+    #include "cashDrawer.h"
+    #include "changeDispatcher.h"
 
     /*
         * Implementación de Programación Dinámica y Programación Voraz para calcular el cambio
@@ -20,6 +30,11 @@
         * Fecha: 29 de agosto de 2024
     */
 
+    // Caché acotada: guarda como máximo CACHE_CAPACITY subproblemas y desaloja con CLOCK,
+    // así el proceso se mantiene dentro de un presupuesto fijo de memoria
+    typedef ClockCache<std::string, std::vector<int>> ChangeCache;
+    const int DEFAULT_CACHE_CAPACITY = 1 << 18;
+
     // Función para medir el tiempo de ejecución
     // Complejidad: O(1) - Tiempo constante para medir el tiempo
     template<typename Func, typename... Args>
@@ -36,16 +51,19 @@
     // Utilizando el Teorema Maestro: T(n) = aT(n/b) + f(n), donde a = 1, b > 1, f(n) = O(n)
     // Caso 3 del Teorema Maestro: T(n) = Θ(n log n)
     std::vector<int> calculateChange(const std::vector<double>& denominations, double change, 
-                                    std::vector<int>& supply, HashTable<std::string, std::vector<int>>& cache) {
+                                    std::vector<int>& supply, ChangeCache& cache) {
         // Redondear el cambio a 2 decimales para evitar problemas de precisión de punto flotante
         change = std::round(change * 100.0) / 100.0;
         
-        // Crear la clave de caché
-        std::string key = std::to_string(change);
+        // Crear la clave de caché en un buffer local (mismo formato que std::to_string, sin reservar memoria)
+        // y calcular su hash una sola vez para la búsqueda y la inserción
+        char keyBuffer[64];
+        std::string_view key(keyBuffer, std::snprintf(keyBuffer, sizeof(keyBuffer), "%f", change));
+        size_t keyHash = cache.hashKey(key);
 
         // Verificar si la solución está en caché
         std::vector<int> result;
-        if (cache.get(key, result)) {
+        if (cache.findWithHash(key, keyHash, result)) {
             return result; // Retorna la solución cacheada si existe
         }
 
@@ -54,7 +72,7 @@
 
         // Caso base: si el cambio es 0, retornar resultado vacío
         if (change < 1e-9) {
-            cache.insert(key, result);
+            cache.insertWithHash(std::string(key), keyHash, result);
             return result;
         }
 
@@ -73,7 +91,7 @@
                     result[i]++;
                     
                     // Cachear esta sub-solución
-                    cache.insert(key, result);
+                    cache.insertWithHash(std::string(key), keyHash, result);
                     return result;
                 }
             }
@@ -81,7 +99,7 @@
 
         // Si no se encontró una solución válida, cachear este hecho
         result[N-1] = -1; // Usar el último elemento como bandera para solución inválida
-        cache.insert(key, result);
+        cache.insertWithHash(std::string(key), keyHash, result);
         return result;
     }
 
@@ -89,16 +107,19 @@
     // Complejidad: O(N), donde N es el número de denominaciones
     // Esta función utiliza un enfoque voraz (greedy) para encontrar una solución local
     std::vector<int> calculateChangeGreedy(const std::vector<double>& denominations, double change, 
-                                        std::vector<int>& supply, HashTable<std::string, std::vector<int>>& cache) {
+                                        std::vector<int>& supply, ChangeCache& cache) {
         // Redondear el cambio a 2 decimales para evitar problemas de precisión de punto flotante
         change = std::round(change * 100.0) / 100.0;
         
-        // Crear la clave de caché
-        std::string key = std::to_string(change);
+        // Crear la clave de caché en un buffer local (mismo formato que std::to_string, sin reservar memoria)
+        // y calcular su hash una sola vez para la búsqueda y la inserción
+        char keyBuffer[64];
+        std::string_view key(keyBuffer, std::snprintf(keyBuffer, sizeof(keyBuffer), "%f", change));
+        size_t keyHash = cache.hashKey(key);
 
         // Verificar si la solución está en caché
         std::vector<int> result;
-        if (cache.get(key, result)) {
+        if (cache.findWithHash(key, keyHash, result)) {
             return result; // Retorna la solución cacheada si existe
         }
 
@@ -121,12 +142,268 @@
         }
 
         // Almacenar el resultado en caché
-        cache.insert(key, result);
+        cache.insertWithHash(std::string(key), keyHash, result);
 
         return result;
     }
 
-    int main() {
+    // Compara el solver recursivo con el motor ChangeDP sobre muchas cantidades con las mismas
+    // denominaciones y suministro. Cada solver usa su propia caché o tabla compartida por todas las consultas.
+    // Complejidad: O(Q * C * N) para el solver recursivo, O(N * A + Q * N) para ChangeDP
+    void runSolverBenchmark(const std::vector<double>& denominations, std::vector<int>& supply,
+                            double maxChange, int queries, int cacheCapacity) {
+        int N = denominations.size();
+        ChangeDP engine(denominations, supply);
+        long long unit = engine.getUnit();
+        long long maxUnits = ChangeDP::toCents(maxChange) / unit;
+
+        // Cantidades aleatorias representables con las denominaciones (múltiplos de la unidad)
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<long long> pick(0, maxUnits);
+        std::vector<double> amounts(queries);
+        for (int q = 0; q < queries; ++q) {
+            amounts[q] = pick(gen) * unit / 100.0;
+        }
+
+        std::vector<std::vector<int>> recursiveResults(queries), dpResults(queries);
+        ChangeCache cache(cacheCapacity);
+        double recursiveTime = measureExecutionTime([&]() {
+            for (int q = 0; q < queries; ++q) {
+                recursiveResults[q] = calculateChange(denominations, amounts[q], supply, cache);
+            }
+        });
+        double buildTime = measureExecutionTime([&]() { engine.build(maxUnits * unit); });
+        double queryTime = measureExecutionTime([&]() {
+            for (int q = 0; q < queries; ++q) {
+                dpResults[q] = engine.solve(amounts[q]);
+            }
+        });
+
+        // Con el mismo número de monedas ambas respuestas son equivalentes; ChangeDP nunca usa más
+        int identical = 0, fewerCoins = 0, feasibilityDiffers = 0;
+        for (int q = 0; q < queries; ++q) {
+            bool recursiveOk = recursiveResults[q][N-1] != -1;
+            bool dpOk = dpResults[q][N-1] != -1;
+            if (recursiveOk != dpOk) {
+                feasibilityDiffers++;
+            } else if (recursiveResults[q] == dpResults[q]) {
+                identical++;
+            } else {
+                int recursiveCoins = 0, dpCoins = 0;
+                for (int j = 0; j < N; ++j) {
+                    recursiveCoins += recursiveResults[q][j];
+                    dpCoins += dpResults[q][j];
+                }
+                fewerCoins += dpCoins < recursiveCoins;
+            }
+        }
+
+        std::cout << "Consultas: " << queries << ", cambio máximo: " << maxChange << " pesos" << std::endl;
+        std::cout << "Solver recursivo (double + caché): " << recursiveTime << " ms" << std::endl;
+        std::cout << "ChangeDP (centavos enteros): construcción " << buildTime << " ms, consultas "
+                  << queryTime << " ms" << std::endl;
+        std::cout << "Respuestas idénticas: " << identical << ", ChangeDP con menos monedas: " << fewerCoins
+                  << ", factibilidad distinta: " << feasibilityDiffers << std::endl;
+    }
+
+    // Modo por lotes: después del suministro la entrada puede traer más pares "P Q" hasta el fin del archivo.
+    // Se leen todos y cada consulta se responde con ChangeDispatcher: voraz cuando es demostrablemente óptimo,
+    // y si no ChangeDP, cuya tabla se construye una sola vez hasta el cambio más grande del lote.
+    // Cada respuesta es una línea de salida; el rendimiento y los caminos tomados se reportan en stderr.
+    // Complejidad: O(N^3 + M * N) para M consultas, más O(N * A) si alguna necesita ChangeDP
+    void runBatch(const std::vector<double>& denominations, const std::vector<int>& supply, double P, double Q) {
+        int N = denominations.size();
+        std::vector<long long> changes;
+        do {
+            changes.push_back(ChangeDP::toCents(Q) - ChangeDP::toCents(P));
+        } while (std::cin >> P >> Q);
+
+        long long maxChange = 0;
+        for (long long cents : changes) {
+            maxChange = std::max(maxChange, cents);
+        }
+
+        std::optional<ChangeDispatcher> dispatcher;
+        double analysisTime = measureExecutionTime([&]() { dispatcher.emplace(denominations, supply); });
+        dispatcher->reserve(maxChange);
+
+        // Las etiquetas " x <denominación>" se formatean una sola vez; la salida se arma en un solo buffer
+        // con std::to_chars (sin locale ni análisis de formato) y se escribe al final
+        std::vector<std::string> labels(N);
+        for (int j = 0; j < N; ++j) {
+            char buffer[32];
+            labels[j] = " x " + std::string(buffer, std::to_chars(buffer, buffer + sizeof(buffer), denominations[j]).ptr);
+        }
+
+        std::string output;
+        output.reserve(changes.size() * 64);
+        double queryTime = measureExecutionTime([&]() {
+            std::vector<int> counts;
+            char buffer[32];
+            for (long long cents : changes) {
+                output += "Cambio ";
+                output.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), cents / 100.0).ptr);
+                output += ':';
+                if (cents < 0) {
+                    output += " pago insuficiente\n";
+                    continue;
+                }
+                if (!dispatcher->solveCents(cents, counts)) {
+                    output += " sin solución\n";
+                    continue;
+                }
+                const char* separator = " ";
+                for (int j = 0; j < N; ++j) {
+                    if (counts[j] > 0) {
+                        output += separator;
+                        output.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), counts[j]).ptr);
+                        output += labels[j];
+                        separator = ", ";
+                    }
+                }
+                output += '\n';
+            }
+        });
+        std::fwrite(output.data(), 1, output.size(), stdout);
+
+        std::cerr << "Consultas: " << changes.size() << ", cambio máximo: " << maxChange / 100.0 << " pesos" << std::endl;
+        std::cerr << "Análisis de denominaciones: " << analysisTime << " ms, respuestas: " << queryTime << " ms ("
+                  << (queryTime > 0 ? changes.size() / queryTime * 1000.0 : 0.0) << " consultas/s)" << std::endl;
+        std::cerr << "Consultas por voraz: " << dispatcher->getGreedyQueries() << ", por ChangeDP: "
+                  << dispatcher->getDPQueries() << std::endl;
+    }
+
+    // Transacción de la bitácora: precio en centavos y monedas con las que paga el cliente
+    struct DrawerTransaction {
+        long long priceCents;
+        std::vector<int> payment;
+    };
+
+    // Genera una bitácora de ventas con precios aleatorios hasta maxPrice. El cliente paga redondeando hacia
+    // arriba a una denominación elegida al azar (pago exacto, al siguiente billete de 100, de 500, ...)
+    // y entrega ese monto con el mínimo de piezas, sin límite de monedas en su cartera.
+    // Complejidad: O(T * N)
+    std::vector<DrawerTransaction> generateTransactionLog(const std::vector<double>& denominations, long long unit,
+                                                          double maxPrice, int transactions) {
+        int N = denominations.size();
+        std::vector<long long> cents(N);
+        for (int i = 0; i < N; ++i) {
+            cents[i] = ChangeDP::toCents(denominations[i]);
+        }
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<long long> pickPrice(1, std::max(1LL, ChangeDP::toCents(maxPrice) / unit));
+        std::uniform_int_distribution<int> pickRounding(0, N - 1);
+        std::vector<DrawerTransaction> log(transactions);
+        for (DrawerTransaction& entry : log) {
+            entry.priceCents = pickPrice(gen) * unit;
+            long long step = std::max(1LL, cents[pickRounding(gen)]);
+            long long remaining = (entry.priceCents + step - 1) / step * step;
+            entry.payment.assign(N, 0);
+            for (int i = 0; i < N; ++i) {
+                if (cents[i] > 0) {
+                    entry.payment[i] = remaining / cents[i];
+                    remaining -= entry.payment[i] * cents[i];
+                }
+            }
+            // Denominaciones que no dividen el monto: se completa con una pieza más de la más chica
+            if (remaining > 0) {
+                entry.payment[N - 1]++;
+            }
+        }
+        return log;
+    }
+
+    // Reproduce una bitácora generada sobre dos cajas con el mismo suministro inicial: una actualiza las tablas
+    // de forma incremental y la otra las reconstruye en cada transacción. Reporta tiempos y verifica que ambas
+    // den el mismo cambio y terminen con el mismo suministro.
+    // Complejidad: O(T * N * A) en el peor caso; con la actualización incremental solo se recalculan las capas
+    // cuyo límite efectivo cambió
+    void runDrawerReplay(const std::vector<double>& denominations, const std::vector<int>& supply,
+                         double maxPrice, int transactions) {
+        int N = denominations.size();
+        long long unit = ChangeDP(denominations, supply).getUnit();
+        std::vector<DrawerTransaction> log = generateTransactionLog(denominations, unit, maxPrice, transactions);
+
+        long long maxChange = 0;
+        for (const DrawerTransaction& entry : log) {
+            long long paid = 0;
+            for (int i = 0; i < N; ++i) {
+                paid += entry.payment[i] * ChangeDP::toCents(denominations[i]);
+            }
+            maxChange = std::max(maxChange, paid - entry.priceCents);
+        }
+
+        CashDrawer incremental(denominations, supply, maxChange, true);
+        CashDrawer rebuild(denominations, supply, maxChange, false);
+        std::vector<std::vector<int>> incrementalChanges(transactions), rebuildChanges(transactions);
+
+        double incrementalTime = measureExecutionTime([&]() {
+            for (int t = 0; t < transactions; ++t) {
+                incremental.transaction(log[t].priceCents, log[t].payment, incrementalChanges[t]);
+            }
+        });
+        double rebuildTime = measureExecutionTime([&]() {
+            for (int t = 0; t < transactions; ++t) {
+                rebuild.transaction(log[t].priceCents, log[t].payment, rebuildChanges[t]);
+            }
+        });
+
+        int mismatches = 0;
+        for (int t = 0; t < transactions; ++t) {
+            mismatches += incrementalChanges[t] != rebuildChanges[t];
+        }
+
+        std::cout << "Transacciones: " << transactions << ", cambio máximo: " << maxChange / 100.0 << " pesos" << std::endl;
+        std::cout << "Aceptadas: " << incremental.getAccepted() << ", rechazadas: " << incremental.getRejected() << std::endl;
+        std::cout << "Actualización incremental: " << incrementalTime << " ms, capas recalculadas: "
+                  << incremental.getLayersRebuilt() << std::endl;
+        std::cout << "Reconstrucción completa: " << rebuildTime << " ms, capas recalculadas: "
+                  << rebuild.getLayersRebuilt() << std::endl;
+        std::cout << "Cambios distintos: " << mismatches << ", suministro final "
+                  << (incremental.getSupply() == rebuild.getSupply() ? "idéntico" : "distinto") << std::endl;
+        std::cout << "Suministro final:";
+        for (int i = 0; i < N; ++i) {
+            std::cout << " " << incremental.getSupply()[i] << " x " << denominations[i];
+        }
+        std::cout << std::endl;
+    }
+
+    // Lee un entero positivo que ocupe todo el argumento; a diferencia de std::stoi no lanza ni acepta basura al final
+    bool parsePositive(const char* text, int& value) {
+        const char* end = text + std::strlen(text);
+        auto [ptr, error] = std::from_chars(text, end, value);
+        return error == std::errc() && ptr == end && value > 0;
+    }
+
+    void printUsage() {
+        std::cerr << "Uso: ./main [capacidad de la caché] < entrada.txt\n"
+                  << "     ./main --benchmark [consultas] < entrada.txt\n"
+                  << "     ./main --batch < entrada.txt\n"
+                  << "     ./main --drawer [transacciones] < entrada.txt" << std::endl;
+    }
+
+    // Uso: ./main [capacidad de la caché] < entrada.txt
+    //      ./main --benchmark [consultas] < entrada.txt
+    //      ./main --batch < entrada.txt (con pares "P Q" adicionales al final)
+    //      ./main --drawer [transacciones] < entrada.txt (precios aleatorios hasta el pago Q de la entrada)
+    int main(int argc, char* argv[]) {
+        // Los argumentos se validan antes de leer la entrada, así un error no se queda esperando stdin
+        std::string mode = argc > 1 ? argv[1] : "";
+        int count = DEFAULT_CACHE_CAPACITY;    // Capacidad de la caché, consultas o transacciones según el modo
+        const char* countArgument = nullptr;
+        if (mode == "--benchmark" || mode == "--drawer") {
+            count = mode == "--benchmark" ? 2000 : 10000;
+            countArgument = argc > 2 ? argv[2] : nullptr;
+        } else if (mode != "--batch") {
+            countArgument = argc > 1 ? argv[1] : nullptr;
+        }
+        if (countArgument && !parsePositive(countArgument, count)) {
+            std::cerr << "Argumento inválido: " << countArgument << std::endl;
+            printUsage();
+            return 1;
+        }
+
         int N;
         double P, Q;
         std::cin >> N;
@@ -147,10 +424,30 @@
             std::cin >> supply[i];
         }
 
+        for (double denomination : denominations) {
+            if (ChangeDP::toCents(denomination) <= 0) {
+                std::cerr << "Denominación inválida: " << denomination << " (debe ser de al menos un centavo)" << std::endl;
+                return 1;
+            }
+        }
+
         double change = Q - P;
 
-        HashTable<std::string, std::vector<int>> cache;
-        HashTable<std::string, std::vector<int>> cacheGreedy;
+        if (mode == "--benchmark") {
+            runSolverBenchmark(denominations, supply, change, count, DEFAULT_CACHE_CAPACITY);
+            return 0;
+        }
+        if (mode == "--batch") {
+            runBatch(denominations, supply, P, Q);
+            return 0;
+        }
+        if (mode == "--drawer") {
+            runDrawerReplay(denominations, supply, Q, count);
+            return 0;
+        }
+
+        ChangeCache cacheGreedy(count);
+        ChangeDispatcher dispatcher(denominations, supply);
 
         std::vector<double> executionTimesOptimal;
         std::vector<double> executionTimesGreedy;
@@ -158,9 +455,10 @@
 
         // Ejecutar ambos algoritmos varias veces para medir su comportamiento
         for (int i = 0; i < 5; ++i) {
-            // Solución óptima con programación dinámica y backtracking
+            // Solución óptima: voraz si el sistema es canónico y alcanza el suministro, si no programación
+            // dinámica ascendente (la primera ejecución que la necesita construye las tablas)
             double executionTimeOptimal = measureExecutionTime([&]() {
-                std::vector<int> result = calculateChange(denominations, change, supply, cache);
+                std::vector<int> result = dispatcher.solve(change);
 
                 if (i == 0) {
                     std::cout << "Solución Óptima:" << std::endl;
@@ -202,6 +500,17 @@
                     << " ms, Tiempo Greedy: " << executionTimeGreedy << " ms" << std::endl;
         }
 
+        std::cout << "Sistema de denominaciones: ";
+        if (dispatcher.isCanonical()) {
+            std::cout << "canónico";
+        } else {
+            std::cout << "no canónico (contraejemplo: " << dispatcher.getCounterexampleCents() / 100.0 << " pesos)";
+        }
+        std::cout << " - consultas por voraz: " << dispatcher.getGreedyQueries() << ", por ChangeDP: "
+                  << dispatcher.getDPQueries() << std::endl;
+        std::cout << "Caché greedy - aciertos: " << cacheGreedy.getHits() << ", fallos: " << cacheGreedy.getMisses()
+                  << ", desalojos: " << cacheGreedy.getEvictions() << std::endl;
+
         return 0;
     }
 
@@ -252,4 +561,7 @@
 
         Es importante notar que, aunque Greedy es generalmente más rápido, no siempre garantiza la solución óptima
         en todos los casos posibles, especialmente en sistemas con restricciones complejas.
+
+        Por eso ChangeDispatcher analiza una vez las denominaciones (prueba de Pearson) y solo usa Greedy cuando
+        el sistema es canónico y ninguna denominación se agota; en los demás casos usa programación dinámica.
         */
\ No newline at end of file
@@ -1,7 +1,18 @@
 #include "../Support/Queue/PriorityQueue.h"
 #include "../Support/Utilities/measureTime.h"
+#include "mazeGrid.h"
+#include <algorithm>
+#include <barrier>
+#include <bit>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
 #include <vector>
 
 /**
@@ -127,7 +138,1020 @@ solveMazeBranchAndBound(const std::vector<std::vector<bool>> &maze, int M,
   return std::vector<std::vector<bool>>(M, std::vector<bool>(N, false));
 }
 
-int main() {
+/**
+ * Función backtrackGrid
+ * Mismo recorrido que solveMazeBacktracking sobre BitGrid, con una función
+ * recursiva normal en lugar de std::function. Las celdas marcadas en solution
+ * forman el camino actual y no se vuelve a entrar en ellas, así la búsqueda
+ * no puede ciclar entre dos celdas libres.
+ * Complejidad Temporal: O(4^n) en el peor caso, como solveMazeBacktracking
+ * Complejidad Espacial: O(n) de recursión, donde n es el largo del camino
+ */
+bool backtrackGrid(const BitGrid &maze, BitGrid &solution, size_t cell,
+                   size_t goal) {
+  if (cell == goal) {
+    solution.set(cell);
+    return true;
+  }
+
+  if (maze.test(cell) && !solution.test(cell)) {
+    solution.set(cell);
+    for (int direction = 0; direction < 4; ++direction) {
+      if (backtrackGrid(maze, solution, cell + maze.offset(direction), goal)) {
+        return true;
+      }
+    }
+    solution.reset(cell);
+  }
+  return false;
+}
+
+/**
+ * Función solveMazeBacktracking sobre BitGrid
+ * Complejidad Temporal: igual que backtrackGrid
+ * Complejidad Espacial: O(m*n) bits para la solución
+ */
+BitGrid solveMazeBacktracking(const BitGrid &maze) {
+  BitGrid solution(maze.rows(), maze.cols());
+  backtrackGrid(maze, solution, maze.index(0, 0),
+                maze.index(maze.rows() - 1, maze.cols() - 1));
+  return solution;
+}
+
+/**
+ * Función solveMazeBranchAndBound sobre BitGrid
+ * Mismo algoritmo que la versión con vectores: visited es un bit por celda y
+ * el padre es la dirección de 2 bits del movimiento que llegó a la celda. El
+ * borde de la rejilla hace innecesario isValid.
+ * Si expanded no es nulo, guarda cuántos nodos se sacaron de la cola.
+ * Complejidad Temporal: O(m*n*log(m*n))
+ * Complejidad Espacial: O(m*n) bits (3 bits por celda más la solución)
+ */
+BitGrid solveMazeBranchAndBound(const BitGrid &maze,
+                                size_t *expanded = nullptr) {
+  int M = maze.rows(), N = maze.cols();
+  std::vector<std::pair<int, int>> moves = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+  BitGrid visited(M, N);
+  DirectionGrid parent(maze);
+  size_t start = maze.index(0, 0);
+
+  auto compare = [](const Node &a, const Node &b) { return a.cost > b.cost; };
+  PriorityQueue<Node, decltype(compare)> pq(compare);
+
+  pq.push(Node(0, 0, 0));
+  visited.set(start);
+  size_t pops = 0;
+
+  while (!pq.empty()) {
+    Node current = pq.top();
+    pq.pop();
+    pops++;
+
+    if (current.x == M - 1 && current.y == N - 1) {
+      BitGrid solution(M, N);
+      size_t cell = maze.index(current.x, current.y);
+      while (cell != start) {
+        solution.set(cell);
+        cell -= maze.offset(parent.get(cell));
+      }
+      solution.set(start);
+      if (expanded) {
+        *expanded = pops;
+      }
+      return solution;
+    }
+
+    size_t cell = maze.index(current.x, current.y);
+    for (int direction = 0; direction < 4; ++direction) {
+      size_t next = cell + maze.offset(direction);
+      if (maze.test(next) && !visited.test(next)) {
+        visited.set(next);
+        parent.set(next, direction);
+        int nextX = current.x + moves[direction].first;
+        int nextY = current.y + moves[direction].second;
+        int newCost = current.cost + 1 + (M - 1 - nextX) +
+                      (N - 1 - nextY); // Manhattan heuristic
+        pq.push(Node(nextX, nextY, newCost));
+      }
+    }
+  }
+
+  if (expanded) {
+    *expanded = pops;
+  }
+  return BitGrid(M, N);
+}
+
+/**
+ * Búsqueda de puntos de salto (JPS) para 4 vecinos
+ * En una rejilla de costo uniforme hay muchos caminos más cortos equivalentes.
+ * JPS solo considera los de forma canónica: primero movimientos verticales
+ * (cambia x) y luego horizontales (cambia y), girando solo donde un obstáculo
+ * lo obliga. Así un movimiento horizontal sigue derecho hasta chocar, llegar
+ * a la meta o pasar junto a un vecino forzado: una celda vertical libre cuya
+ * vecina de la columna anterior está bloqueada. Un movimiento vertical se
+ * detiene donde un salto horizontal encontraría algo. Solo esas celdas (los
+ * puntos de salto) entran a la cola.
+ *
+ * JumpTable es la versión JPS+: guarda para cada celda y dirección la
+ * distancia al siguiente punto de salto (positiva) o, si no hay, menos el
+ * número de celdas libres antes de la pared. No depende de la meta, así que
+ * se calcula una vez por laberinto y cada salto cuesta O(1).
+ */
+const size_t NO_JUMP = SIZE_MAX;
+
+bool isHorizontal(int direction) { return direction & 1; }
+
+/**
+ * Función hasForcedNeighbor
+ * Complejidad Temporal: O(1)
+ */
+bool hasForcedNeighbor(const BitGrid &maze, size_t cell, int direction) {
+  ptrdiff_t back = maze.offset(direction);
+  for (int vertical = 0; vertical < 4; vertical += 2) {
+    size_t side = cell + maze.offset(vertical);
+    if (maze.test(side) && !maze.test(side - back)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Función jumpHorizontal / jumpVertical
+ * Siguiente punto de salto desde cell en la dirección dada, o NO_JUMP
+ * Complejidad Temporal: O(n) para jumpHorizontal y O(n^2) para jumpVertical
+ * en el peor caso, donde n es el lado del laberinto
+ */
+size_t jumpHorizontal(const BitGrid &maze, size_t cell, int direction,
+                      size_t goal) {
+  ptrdiff_t step = maze.offset(direction);
+  while (true) {
+    cell += step;
+    if (!maze.test(cell)) {
+      return NO_JUMP;
+    }
+    if (cell == goal || hasForcedNeighbor(maze, cell, direction)) {
+      return cell;
+    }
+  }
+}
+
+size_t jumpVertical(const BitGrid &maze, size_t cell, int direction,
+                    size_t goal) {
+  ptrdiff_t step = maze.offset(direction);
+  while (true) {
+    cell += step;
+    if (!maze.test(cell)) {
+      return NO_JUMP;
+    }
+    if (cell == goal || jumpHorizontal(maze, cell, 1, goal) != NO_JUMP ||
+        jumpHorizontal(maze, cell, 3, goal) != NO_JUMP) {
+      return cell;
+    }
+  }
+}
+
+class JumpTable {
+public:
+  /**
+   * Se recorre cada dirección desde la pared hacia atrás, así la distancia de
+   * una celda sale de la de su vecina. Las horizontales van primero porque
+   * los puntos de salto verticales dependen de ellas.
+   * Complejidad Temporal: O(m*n)
+   * Complejidad Espacial: 4 enteros por celda
+   */
+  explicit JumpTable(const BitGrid &maze)
+      : distances(maze.cells() * 4, 0) {
+    int M = maze.rows(), N = maze.cols();
+    for (int direction : {1, 3, 0, 2}) {
+      bool forward = direction < 2;
+      ptrdiff_t step = maze.offset(direction);
+      for (int a = 0; a < M; ++a) {
+        for (int b = 0; b < N; ++b) {
+          int x = forward ? M - 1 - a : a, y = forward ? N - 1 - b : b;
+          size_t cell = maze.index(x, y), next = cell + step;
+          int &distance = distances[cell * 4 + direction];
+          int after = distances[next * 4 + direction];
+          if (!maze.test(next)) {
+            distance = 0;
+          } else if (isHorizontal(direction)
+                         ? hasForcedNeighbor(maze, next, direction)
+                         : get(next, 1) > 0 || get(next, 3) > 0) {
+            distance = 1;
+          } else {
+            distance = after > 0 ? after + 1 : after - 1;
+          }
+        }
+      }
+    }
+  }
+
+  int get(size_t cell, int direction) const {
+    return distances[cell * 4 + direction];
+  }
+
+  size_t memoryBytes() const { return distances.size() * sizeof(int); }
+
+private:
+  std::vector<int> distances;
+};
+
+/**
+ * Función jumpWithTable
+ * Mismo resultado que jumpHorizontal / jumpVertical, en O(1): la meta solo
+ * cambia el resultado si queda en la misma línea del salto, o (en un salto
+ * vertical) en una fila desde la que un salto horizontal la alcanza.
+ */
+size_t jumpWithTable(const BitGrid &maze, const JumpTable &table, size_t cell,
+                     int direction, size_t goal) {
+  int distance = table.get(cell, direction);
+  int reach = std::abs(distance);
+  int dx = maze.rowOf(goal) - maze.rowOf(cell);
+  int dy = maze.colOf(goal) - maze.colOf(cell);
+  int sign = direction < 2 ? 1 : -1;
+  int along = (isHorizontal(direction) ? dy : dx) * sign;
+  int across = isHorizontal(direction) ? dx : dy;
+
+  if (along > 0 && along <= reach) {
+    if (across == 0) {
+      return goal;
+    }
+    size_t row = cell + along * maze.offset(direction);
+    int sideways = across > 0 ? 1 : 3;
+    if (!isHorizontal(direction) &&
+        std::abs(across) <= std::abs(table.get(row, sideways))) {
+      return row;
+    }
+  }
+  return distance > 0 ? cell + distance * maze.offset(direction) : NO_JUMP;
+}
+
+/**
+ * Función solveMazeJPS
+ * A* sobre los puntos de salto con los mismos Node y PriorityQueue que
+ * Ramificación y Poda; cost es f = g + h con h Manhattan. g se guarda por
+ * celda y las entradas viejas de la cola se descartan al sacarlas. Cada
+ * celda guarda la dirección con la que se llegó a ella; el camino se
+ * reconstruye caminando hacia atrás hasta una celda expandida cuyo g
+ * corresponde a la distancia recorrida. Con table se usan los saltos JPS+.
+ * Si expanded no es nulo, guarda cuántos puntos de salto se expandieron.
+ * Complejidad Temporal: O(m*n*log(m*n)) en el peor caso; en laberintos
+ * abiertos expande muchas menos celdas que A*
+ * Complejidad Espacial: O(m*n)
+ */
+BitGrid solveMazeJPS(const BitGrid &maze, const JumpTable *table = nullptr,
+                     size_t *expanded = nullptr) {
+  int M = maze.rows(), N = maze.cols();
+  size_t start = maze.index(0, 0), goal = maze.index(M - 1, N - 1);
+  BitGrid closed(M, N);
+  DirectionGrid arrival(maze);
+  std::vector<int> g(maze.cells(), INT_MAX);
+  size_t pops = 0;
+
+  // Con f igual, x + y mayor es h menor y g mayor, como en solveMazeAStar
+  auto compare = [](const Node &a, const Node &b) {
+    return a.cost > b.cost || (a.cost == b.cost && a.x + a.y < b.x + b.y);
+  };
+  PriorityQueue<Node, decltype(compare)> pq(compare);
+
+  g[start] = 0;
+  pq.push(Node(0, 0, (M - 1) + (N - 1)));
+
+  while (!pq.empty()) {
+    Node current = pq.top();
+    pq.pop();
+    size_t cell = maze.index(current.x, current.y);
+    if (closed.test(cell)) {
+      continue;
+    }
+    closed.set(cell);
+    pops++;
+
+    if (cell == goal) {
+      BitGrid solution(M, N);
+      int distance = g[cell];
+      solution.set(cell);
+      while (cell != start) {
+        int direction = arrival.get(cell);
+        int steps = 0;
+        do {
+          cell -= maze.offset(direction);
+          solution.set(cell);
+          steps++;
+        } while (!(closed.test(cell) && g[cell] == distance - steps));
+        distance -= steps;
+      }
+      if (expanded) {
+        *expanded = pops;
+      }
+      return solution;
+    }
+
+    // Direcciones canónicas según cómo se llegó: desde el inicio todas; tras
+    // un movimiento vertical se sigue derecho o se gira a cualquier lado;
+    // tras uno horizontal se sigue derecho y solo se gira a vecinos forzados
+    int from = arrival.get(cell);
+    for (int direction = 0; direction < 4; ++direction) {
+      if (cell != start && direction == (from + 2) % 4) {
+        continue;
+      }
+      if (cell != start && isHorizontal(from) && direction != from) {
+        size_t side = cell + maze.offset(direction);
+        if (!maze.test(side) || maze.test(side - maze.offset(from))) {
+          continue;
+        }
+      }
+
+      size_t next;
+      if (table) {
+        next = jumpWithTable(maze, *table, cell, direction, goal);
+      } else if (isHorizontal(direction)) {
+        next = jumpHorizontal(maze, cell, direction, goal);
+      } else {
+        next = jumpVertical(maze, cell, direction, goal);
+      }
+      if (next == NO_JUMP || closed.test(next)) {
+        continue;
+      }
+
+      int nextX = maze.rowOf(next), nextY = maze.colOf(next);
+      int nextG = g[cell] + std::abs(nextX - current.x) +
+                  std::abs(nextY - current.y);
+      if (nextG < g[next]) {
+        g[next] = nextG;
+        arrival.set(next, direction);
+        pq.push(Node(nextX, nextY, nextG + (M - 1 - nextX) + (N - 1 - nextY)));
+      }
+    }
+  }
+
+  if (expanded) {
+    *expanded = pops;
+  }
+  return BitGrid(M, N);
+}
+
+/**
+ * Función solveMazeIterativeDFS
+ * Búsqueda en profundidad sin recursión, en el mismo orden de movimientos que
+ * solveMazeBacktracking. Cada marco de la pila guarda la celda y la siguiente
+ * dirección por probar, empacadas en 64 bits; la pila se reserva al inicio
+ * con una entrada por celda libre, que es su profundidad máxima. Cada celda
+ * se marca como visitada al entrar y nunca se vuelve a entrar en ella, así
+ * que la búsqueda termina aunque el laberinto tenga ciclos. Al llegar a la
+ * meta la pila es el camino.
+ * Complejidad Temporal: O(m*n)
+ * Complejidad Espacial: O(m*n) bits para visitados más 8 bytes por marco
+ */
+BitGrid solveMazeIterativeDFS(const BitGrid &maze) {
+  int M = maze.rows(), N = maze.cols();
+  BitGrid solution(M, N);
+  size_t start = maze.index(0, 0), goal = maze.index(M - 1, N - 1);
+  if (start == goal) {
+    solution.set(start);
+    return solution;
+  }
+  if (!maze.test(start)) {
+    return solution;
+  }
+
+  // Marco: celda << 3 | siguiente dirección (4 = sin direcciones pendientes)
+  std::vector<uint64_t> stack;
+  stack.reserve(maze.count() + 1);
+  BitGrid visited(M, N);
+  visited.set(start);
+  stack.push_back(uint64_t(start) << 3);
+
+  bool found = false;
+  while (!stack.empty() && !found) {
+    uint64_t &frame = stack.back();
+    int direction = frame & 7;
+    if (direction == 4) {
+      stack.pop_back();
+      continue;
+    }
+    frame++;
+
+    size_t next = (frame >> 3) + maze.offset(direction);
+    if (next == goal) {
+      stack.push_back(uint64_t(next) << 3);
+      found = true;
+    } else if (maze.test(next) && !visited.test(next)) {
+      visited.set(next);
+      stack.push_back(uint64_t(next) << 3);
+    }
+  }
+
+  if (found) {
+    for (uint64_t frame : stack) {
+      solution.set(frame >> 3);
+    }
+  }
+  return solution;
+}
+
+/**
+ * Función solveMazeAStar
+ * A* sobre BitGrid con g (pasos desde el inicio) y h (distancia Manhattan a la
+ * meta) separados; se expande primero el menor f = g + h y, con empate, el de
+ * mayor g, que está más cerca de la meta. La cola es un heap 4-ario indexado
+ * por celda: si se encuentra un camino más corto a una celda que ya está en
+ * la cola se mejora su prioridad con decrease_key en lugar de insertarla otra
+ * vez. Como la heurística es consistente, una celda cerrada (ya expandida)
+ * tiene su g definitivo y no se vuelve a abrir, y el camino es el más corto.
+ * Si expanded no es nulo, guarda cuántas celdas se expandieron.
+ * Complejidad Temporal: O(m*n*log(m*n)) en el peor caso
+ * Complejidad Espacial: O(m*n): g y la posición en el heap son enteros por
+ * celda; cerrados y padres son bits
+ */
+BitGrid solveMazeAStar(const BitGrid &maze, size_t *expanded = nullptr) {
+  int M = maze.rows(), N = maze.cols();
+  size_t start = maze.index(0, 0), goal = maze.index(M - 1, N - 1);
+  BitGrid closed(M, N);
+  DirectionGrid parent(maze);
+  std::vector<int> g(maze.cells(), INT_MAX);
+  size_t pops = 0;
+
+  struct Priority {
+    int f, g;
+  };
+  auto compare = [](const Priority &a, const Priority &b) {
+    return a.f > b.f || (a.f == b.f && a.g < b.g);
+  };
+  IndexedPriorityQueue<Priority, decltype(compare), 4> open(maze.cells(),
+                                                             compare);
+  auto heuristic = [&](size_t cell) {
+    return (M - 1 - maze.rowOf(cell)) + (N - 1 - maze.colOf(cell));
+  };
+
+  g[start] = 0;
+  open.push(start, {heuristic(start), 0});
+
+  while (!open.empty()) {
+    size_t cell = open.top();
+    open.pop();
+    closed.set(cell);
+    pops++;
+
+    if (cell == goal) {
+      BitGrid solution(M, N);
+      while (cell != start) {
+        solution.set(cell);
+        cell -= maze.offset(parent.get(cell));
+      }
+      solution.set(start);
+      if (expanded) {
+        *expanded = pops;
+      }
+      return solution;
+    }
+
+    int nextG = g[cell] + 1;
+    for (int direction = 0; direction < 4; ++direction) {
+      size_t next = cell + maze.offset(direction);
+      if (!maze.test(next) || closed.test(next) || nextG >= g[next]) {
+        continue;
+      }
+      g[next] = nextG;
+      parent.set(next, direction);
+      Priority priority = {nextG + heuristic(next), nextG};
+      if (open.contains(next)) {
+        open.decrease_key(next, priority);
+      } else {
+        open.push(next, priority);
+      }
+    }
+  }
+
+  if (expanded) {
+    *expanded = pops;
+  }
+  return BitGrid(M, N);
+}
+
+/**
+ * Función solveMazeBidirectionalBFS
+ * BFS desde (0, 0) y desde (M-1, N-1) a la vez; en cada paso se expande un
+ * nivel completo del lado con la frontera más chica. La primera vez que un
+ * lado toca una celda visitada por el otro, los dos árboles se unen en un
+ * camino más corto: todas las celdas del otro lado que se pueden tocar en ese
+ * nivel están en su última frontera, así que cualquier encuentro del nivel da
+ * el mismo largo. Cada lado tiene sus propios bits de visitado y direcciones
+ * de padre. Si expanded no es nulo, guarda cuántas celdas se expandieron.
+ * Complejidad Temporal: O(m*n) en el peor caso; en laberintos abiertos cada
+ * lado solo llega a la mitad de la distancia
+ * Complejidad Espacial: O(m*n) bits más las fronteras
+ */
+BitGrid solveMazeBidirectionalBFS(const BitGrid &maze,
+                                  size_t *expanded = nullptr) {
+  int M = maze.rows(), N = maze.cols();
+  size_t start = maze.index(0, 0), goal = maze.index(M - 1, N - 1);
+  BitGrid solution(M, N);
+  if (start == goal) {
+    solution.set(start);
+    return solution;
+  }
+  if (!maze.test(goal)) {
+    return solution;
+  }
+
+  // Lado 0: desde el inicio. Lado 1: desde la meta
+  size_t roots[2] = {start, goal};
+  BitGrid visited[2] = {BitGrid(M, N), BitGrid(M, N)};
+  DirectionGrid parent[2] = {DirectionGrid(maze), DirectionGrid(maze)};
+  std::vector<size_t> frontier[2] = {{start}, {goal}}, next;
+  visited[0].set(start);
+  visited[1].set(goal);
+  size_t pops = 0;
+
+  int meetSide = -1;
+  size_t meetCell = 0, meetNext = 0;
+  while (meetSide < 0 && !frontier[0].empty() && !frontier[1].empty()) {
+    int side = frontier[0].size() <= frontier[1].size() ? 0 : 1;
+    next.clear();
+    for (size_t cell : frontier[side]) {
+      pops++;
+      for (int direction = 0; direction < 4 && meetSide < 0; ++direction) {
+        size_t neighbor = cell + maze.offset(direction);
+        if (visited[1 - side].test(neighbor)) {
+          meetSide = side;
+          meetCell = cell;
+          meetNext = neighbor;
+        } else if (maze.test(neighbor) && !visited[side].test(neighbor)) {
+          visited[side].set(neighbor);
+          parent[side].set(neighbor, direction);
+          next.push_back(neighbor);
+        }
+      }
+      if (meetSide >= 0) {
+        break;
+      }
+    }
+    frontier[side].swap(next);
+  }
+
+  if (expanded) {
+    *expanded = pops;
+  }
+  if (meetSide >= 0) {
+    auto trace = [&](int side, size_t cell) {
+      while (cell != roots[side]) {
+        solution.set(cell);
+        cell -= maze.offset(parent[side].get(cell));
+      }
+      solution.set(cell);
+    };
+    trace(meetSide, meetCell);
+    trace(1 - meetSide, meetNext);
+  }
+  return solution;
+}
+
+struct ParallelBFSStats {
+  size_t levels = 0;
+  size_t bottomUpLevels = 0;
+  size_t visited = 0;
+};
+
+/**
+ * Función solveMazeParallelBFS
+ * BFS sincronizado por niveles: todos los hilos expanden la frontera actual y
+ * se esperan en una barrera antes del siguiente nivel; la función de la
+ * barrera junta la frontera nueva y decide la dirección del siguiente nivel
+ * (direction-optimizing, Beamer et al.):
+ * - Arriba-abajo: cada hilo toma una parte de la frontera y reclama a sus
+ *   vecinos libres con claim sobre los bits atómicos de visitado; solo el
+ *   hilo que gana una celda escribe su padre y la agrega a su frontera local.
+ * - Abajo-arriba: cada hilo toma un rango de palabras y busca, para cada
+ *   celda libre no visitada, un vecino en la frontera (guardada como bits).
+ *   Cada hilo solo escribe sus propias palabras, así que no hay conflictos.
+ * Se pasa a abajo-arriba cuando la frontera es grande respecto a lo que falta
+ * por visitar (más de 1/ALPHA) y se regresa cuando se encoge a menos de
+ * 1/BETA de las celdas libres. Los niveles con menos de SERIAL_FRONTIER
+ * celdas los expande un solo hilo, sin barrera. El padre es un byte por celda
+ * para que cada hilo lo escriba sin tocar el de otra celda.
+ * Complejidad Temporal: O(m*n / p) por nivel abajo-arriba y O(frontera / p)
+ * por nivel arriba-abajo, con p hilos, más una barrera por nivel
+ * Complejidad Espacial: O(m*n) (tres rejillas de bits y un byte por celda)
+ */
+BitGrid solveMazeParallelBFS(const BitGrid &maze, int threads,
+                             ParallelBFSStats *stats = nullptr) {
+  const size_t ALPHA = 14, BETA = 24, SERIAL_FRONTIER = 1024;
+  int M = maze.rows(), N = maze.cols();
+  size_t start = maze.index(0, 0), goal = maze.index(M - 1, N - 1);
+  BitGrid solution(M, N);
+  if (start == goal) {
+    solution.set(start);
+    return solution;
+  }
+  if (!maze.test(goal)) {
+    return solution;
+  }
+  threads = std::max(threads, 1);
+
+  AtomicBitGrid visited(maze), bitsA(maze), bitsB(maze);
+  AtomicBitGrid *current = &bitsA, *upcoming = &bitsB;
+  std::vector<uint8_t> parent(maze.cells());
+  std::vector<size_t> frontier = {start};
+  std::vector<std::vector<size_t>> localFrontiers(threads);
+  std::vector<size_t> localCounts(threads);
+  visited.claim(start);
+
+  size_t words = maze.wordCount();
+  size_t open = maze.count() + (maze.test(start) ? 0 : 1);
+  size_t unexplored = open - 1, frontierSize = 1;
+  bool bottomUp = false, done = false;
+  ParallelBFSStats result;
+  result.visited = 1;
+
+  auto expandTopDown = [&](int t) {
+    std::vector<size_t> &local = localFrontiers[t];
+    local.clear();
+    size_t begin = frontier.size() * t / threads;
+    size_t end = frontier.size() * (t + 1) / threads;
+    for (size_t i = begin; i < end; ++i) {
+      for (int direction = 0; direction < 4; ++direction) {
+        size_t next = frontier[i] + maze.offset(direction);
+        if (maze.test(next) && visited.claim(next)) {
+          parent[next] = direction;
+          local.push_back(next);
+        }
+      }
+    }
+  };
+
+  auto expandBottomUp = [&](int t) {
+    size_t begin = words * t / threads, end = words * (t + 1) / threads;
+    upcoming->clear(begin, end);
+    size_t count = 0;
+    for (size_t w = begin; w < end; ++w) {
+      uint64_t candidates = maze.word(w) & ~visited.word(w), claimed = 0;
+      while (candidates) {
+        int bit = std::countr_zero(candidates);
+        candidates &= candidates - 1;
+        size_t cell = w * 64 + bit;
+        for (int direction = 0; direction < 4; ++direction) {
+          if (current->test(cell + maze.offset(direction))) {
+            parent[cell] = (direction + 2) % 4;
+            claimed |= uint64_t(1) << bit;
+            break;
+          }
+        }
+      }
+      if (claimed) {
+        visited.orWord(w, claimed);
+        upcoming->orWord(w, claimed);
+        count += std::popcount(claimed);
+      }
+    }
+    localCounts[t] = count;
+  };
+
+  // Junta la frontera nueva y decide la dirección del siguiente nivel
+  auto collectLevel = [&]() {
+    size_t previousSize = frontierSize;
+    result.levels++;
+    if (bottomUp) {
+      result.bottomUpLevels++;
+      frontierSize = 0;
+      for (size_t count : localCounts) {
+        frontierSize += count;
+      }
+      std::swap(current, upcoming);
+    } else {
+      frontier.clear();
+      for (const auto &local : localFrontiers) {
+        frontier.insert(frontier.end(), local.begin(), local.end());
+      }
+      frontierSize = frontier.size();
+    }
+    unexplored -= frontierSize;
+    result.visited += frontierSize;
+    if (frontierSize == 0 || visited.test(goal)) {
+      done = true;
+      return;
+    }
+
+    if (!bottomUp && frontierSize * ALPHA > unexplored) {
+      bottomUp = true;
+      current->clear(0, words);
+      for (size_t cell : frontier) {
+        current->orWord(cell >> 6, uint64_t(1) << (cell & 63));
+      }
+    } else if (bottomUp && frontierSize < previousSize &&
+               frontierSize * BETA < open) {
+      bottomUp = false;
+      frontier.clear();
+      for (size_t w = 0; w < words; ++w) {
+        for (uint64_t bits = current->word(w); bits; bits &= bits - 1) {
+          frontier.push_back(w * 64 + std::countr_zero(bits));
+        }
+      }
+    }
+  };
+
+  // Mientras la frontera es chica (por ejemplo en pasillos) un nivel cuesta
+  // menos que la barrera, así que el hilo que la está completando lo expande
+  // solo
+  auto runSmallLevels = [&]() {
+    while (!done && !bottomUp && frontier.size() < SERIAL_FRONTIER) {
+      for (int t = 0; t < threads; ++t) {
+        expandTopDown(t);
+      }
+      collectLevel();
+    }
+  };
+
+  // La corre un solo hilo cuando todos llegaron a la barrera
+  auto finishLevel = [&]() noexcept {
+    collectLevel();
+    runSmallLevels();
+  };
+
+  runSmallLevels();
+  std::barrier sync(threads, finishLevel);
+  auto worker = [&](int t) {
+    while (!done) {
+      bottomUp ? expandBottomUp(t) : expandTopDown(t);
+      sync.arrive_and_wait();
+    }
+  };
+  std::vector<std::thread> pool;
+  for (int t = 1; t < threads; ++t) {
+    pool.emplace_back(worker, t);
+  }
+  worker(0);
+  for (std::thread &thread : pool) {
+    thread.join();
+  }
+
+  if (stats) {
+    *stats = result;
+  }
+  if (visited.test(goal)) {
+    size_t cell = goal;
+    while (cell != start) {
+      solution.set(cell);
+      cell -= maze.offset(parent[cell]);
+    }
+    solution.set(start);
+  }
+  return solution;
+}
+
+/**
+ * Función toBitGrid / toVectorMaze
+ * Conversión entre las dos representaciones del laberinto
+ * Complejidad Temporal: O(m*n)
+ */
+BitGrid toBitGrid(const std::vector<std::vector<bool>> &maze, int M, int N) {
+  BitGrid grid(M, N);
+  for (int i = 0; i < M; ++i) {
+    for (int j = 0; j < N; ++j) {
+      grid.set(i, j, maze[i][j]);
+    }
+  }
+  return grid;
+}
+
+std::vector<std::vector<bool>> toVectorMaze(const BitGrid &grid) {
+  std::vector<std::vector<bool>> maze(grid.rows(),
+                                      std::vector<bool>(grid.cols()));
+  for (int i = 0; i < grid.rows(); ++i) {
+    for (int j = 0; j < grid.cols(); ++j) {
+      maze[i][j] = grid.get(i, j);
+    }
+  }
+  return maze;
+}
+
+/**
+ * Función generateMaze
+ * Laberinto perfecto de M x N: las celdas con ambas coordenadas pares son
+ * cuartos y un DFS aleatorio con pila explícita derriba las paredes entre
+ * ellos. Después se abre cada pared restante con probabilidad openness (0 deja
+ * solo pasillos, 1 deja la rejilla vacía) y se conecta (M-1, N-1) con el
+ * cuarto más cercano, así siempre hay camino desde (0, 0).
+ * Complejidad Temporal: O(m*n)
+ * Complejidad Espacial: O(m*n)
+ */
+BitGrid generateMaze(int M, int N, double openness, unsigned seed) {
+  BitGrid maze(M, N);
+  BitGrid seen(M, N);
+  std::mt19937 gen(seed);
+  std::vector<std::pair<int, int>> moves = {{2, 0}, {0, 2}, {-2, 0}, {0, -2}};
+
+  std::vector<std::pair<int, int>> stack = {{0, 0}};
+  maze.set(0, 0, true);
+  seen.set(0, 0, true);
+  while (!stack.empty()) {
+    auto [x, y] = stack.back();
+    int options[4], count = 0;
+    for (int d = 0; d < 4; ++d) {
+      int nextX = x + moves[d].first, nextY = y + moves[d].second;
+      if (isValid(nextX, nextY, M, N) && !seen.get(nextX, nextY)) {
+        options[count++] = d;
+      }
+    }
+    if (count == 0) {
+      stack.pop_back();
+      continue;
+    }
+    int d = options[gen() % count];
+    int nextX = x + moves[d].first, nextY = y + moves[d].second;
+    maze.set(x + moves[d].first / 2, y + moves[d].second / 2, true);
+    maze.set(nextX, nextY, true);
+    seen.set(nextX, nextY, true);
+    stack.push_back({nextX, nextY});
+  }
+
+  std::bernoulli_distribution open(openness);
+  for (int i = 0; i < M; ++i) {
+    for (int j = 0; j < N; ++j) {
+      if (!maze.get(i, j) && open(gen)) {
+        maze.set(i, j, true);
+      }
+    }
+  }
+
+  int x = M - 1, y = N - 1;
+  maze.set(x, y, true);
+  if (x % 2) {
+    maze.set(--x, y, true);
+  }
+  if (y % 2) {
+    maze.set(x, --y, true);
+  }
+  return maze;
+}
+
+/**
+ * Función runGridBenchmark
+ * Resuelve el mismo laberinto generado con Ramificación y Poda sobre vectores
+ * de vectores y sobre BitGrid, y reporta tiempo, memoria de las estructuras
+ * por celda (laberinto, visitados, padres y solución) y si los caminos
+ * coinciden. También mide la búsqueda en profundidad iterativa, que a
+ * diferencia del backtracking recursivo no desborda la pila a este tamaño.
+ * Por último compara Ramificación y Poda con A*: nodos expandidos, tiempo y
+ * largo del camino.
+ * Complejidad Temporal: O(m*n*log(m*n))
+ */
+void runGridBenchmark(int size, double openness) {
+  BitGrid grid = generateMaze(size, size, openness, 42);
+  std::vector<std::vector<bool>> maze = toVectorMaze(grid);
+
+  std::vector<std::vector<bool>> solutionVectors;
+  double timeVectors = ExecutionTimer::measureExecutionTime(
+      [&]() { solutionVectors = solveMazeBranchAndBound(maze, size, size); });
+  BitGrid solutionGrid(size, size);
+  double timeGrid = ExecutionTimer::measureExecutionTime(
+      [&]() { solutionGrid = solveMazeBranchAndBound(grid); });
+
+  // vector<vector<bool>>: un vector por fila más sus palabras; los padres son
+  // un par de int por celda
+  size_t rows = size, cols = size;
+  size_t bitRow = sizeof(std::vector<bool>) + (cols + 63) / 64 * 8;
+  size_t parentRow =
+      sizeof(std::vector<std::pair<int, int>>) + cols * sizeof(std::pair<int, int>);
+  size_t bytesVectors = rows * (3 * bitRow + parentRow);
+  size_t bytesGrid =
+      3 * grid.memoryBytes() + DirectionGrid(grid).memoryBytes();
+
+  std::cout << "Laberinto: " << size << " x " << size
+            << ", apertura: " << openness << std::endl;
+  std::cout << "Vectores de vectores: " << timeVectors << " ms, "
+            << bytesVectors / 1048576.0 << " MB" << std::endl;
+  std::cout << "BitGrid: " << timeGrid << " ms, " << bytesGrid / 1048576.0
+            << " MB" << std::endl;
+  std::cout << "Caminos iguales: "
+            << (toVectorMaze(solutionGrid) == solutionVectors ? "si" : "no")
+            << std::endl;
+
+  BitGrid solutionDFS(size, size);
+  double timeDFS = ExecutionTimer::measureExecutionTime(
+      [&]() { solutionDFS = solveMazeIterativeDFS(grid); });
+  std::cout << "DFS iterativo: " << timeDFS << " ms, largo del camino: "
+            << solutionDFS.count() << std::endl;
+
+  size_t expandedBranchAndBound = 0, expandedAStar = 0;
+  double timeBranchAndBound = ExecutionTimer::measureExecutionTime([&]() {
+    solutionGrid = solveMazeBranchAndBound(grid, &expandedBranchAndBound);
+  });
+  BitGrid solutionAStar(size, size);
+  double timeAStar = ExecutionTimer::measureExecutionTime(
+      [&]() { solutionAStar = solveMazeAStar(grid, &expandedAStar); });
+  std::cout << "Ramificacion y poda: " << expandedBranchAndBound
+            << " nodos expandidos, " << timeBranchAndBound
+            << " ms, largo del camino: " << solutionGrid.count() << std::endl;
+  std::cout << "A*: " << expandedAStar << " nodos expandidos, " << timeAStar
+            << " ms, largo del camino: " << solutionAStar.count() << std::endl;
+}
+
+/**
+ * Función runJPSBenchmark
+ * Compara Ramificación y Poda, A*, JPS y JPS+ en un laberinto de pasillos
+ * (apertura 0) y en uno casi abierto: nodos expandidos, tiempo y largo del
+ * camino. El tiempo de JPS+ no incluye construir la tabla, que se reporta
+ * aparte porque se paga una vez por laberinto.
+ * Complejidad Temporal: O(m*n*log(m*n))
+ */
+void runJPSBenchmark(int size) {
+  for (double openness : {0.0, 0.75}) {
+    BitGrid grid = generateMaze(size, size, openness, 42);
+    std::cout << "Laberinto: " << size << " x " << size
+              << ", apertura: " << openness << std::endl;
+
+    auto report = [&](const std::string &name, auto solve) {
+      size_t expanded = 0;
+      BitGrid solution(size, size);
+      double time = ExecutionTimer::measureExecutionTime(
+          [&]() { solution = solve(&expanded); });
+      std::cout << name << ": " << expanded << " nodos expandidos, " << time
+                << " ms, largo del camino: " << solution.count() << std::endl;
+    };
+    report("Ramificacion y poda", [&](size_t *expanded) {
+      return solveMazeBranchAndBound(grid, expanded);
+    });
+    report("A*", [&](size_t *expanded) {
+      return solveMazeAStar(grid, expanded);
+    });
+    report("JPS", [&](size_t *expanded) {
+      return solveMazeJPS(grid, nullptr, expanded);
+    });
+
+    std::optional<JumpTable> table;
+    double timeTable = ExecutionTimer::measureExecutionTime(
+        [&]() { table.emplace(grid); });
+    std::cout << "Tabla JPS+: " << timeTable << " ms, "
+              << table->memoryBytes() / 1048576.0 << " MB" << std::endl;
+    report("JPS+", [&](size_t *expanded) {
+      return solveMazeJPS(grid, &*table, expanded);
+    });
+    std::cout << std::endl;
+  }
+}
+
+/**
+ * Función runBFSBenchmark
+ * Caminos más cortos en un laberinto grande (7072 x 7072 son unos 50 millones
+ * de celdas): BFS bidireccional y BFS paralelo con 1 hilo y con los hilos
+ * pedidos. Reporta tiempo, celdas visitadas, niveles y largo del camino.
+ * Complejidad Temporal: O(m*n)
+ */
+void runBFSBenchmark(int size, double openness, int threads) {
+  BitGrid grid = generateMaze(size, size, openness, 42);
+  std::cout << "Laberinto: " << size << " x " << size
+            << ", apertura: " << openness << std::endl;
+
+  size_t expanded = 0;
+  BitGrid solution(size, size);
+  double time = ExecutionTimer::measureExecutionTime(
+      [&]() { solution = solveMazeBidirectionalBFS(grid, &expanded); });
+  std::cout << "BFS bidireccional: " << time << " ms, " << expanded
+            << " celdas expandidas, largo del camino: " << solution.count()
+            << std::endl;
+
+  for (int count : {1, threads}) {
+    ParallelBFSStats stats;
+    time = ExecutionTimer::measureExecutionTime(
+        [&]() { solution = solveMazeParallelBFS(grid, count, &stats); });
+    std::cout << "BFS paralelo (" << count << " hilos): " << time << " ms, "
+              << stats.visited << " celdas visitadas, " << stats.levels
+              << " niveles (" << stats.bottomUpLevels
+              << " abajo-arriba), largo del camino: " << solution.count()
+              << std::endl;
+    if (threads == 1) {
+      break;
+    }
+  }
+}
+
+// Uso: ./main < entrada.txt
+//      ./main --benchmark [tamaño] [apertura]
+//      ./main --jps-benchmark [tamaño]
+//      ./main --bfs-benchmark [tamaño] [apertura] [hilos]
+int main(int argc, char *argv[]) {
+  std::string mode = argc > 1 ? argv[1] : "";
+  if (mode == "--benchmark") {
+    int size = argc > 2 ? std::stoi(argv[2]) : 10000;
+    double openness = argc > 3 ? std::stod(argv[3]) : 0.1;
+    runGridBenchmark(size, openness);
+    return 0;
+  }
+  if (mode == "--jps-benchmark") {
+    runJPSBenchmark(argc > 2 ? std::stoi(argv[2]) : 2000);
+    return 0;
+  }
+  if (mode == "--bfs-benchmark") {
+    int size = argc > 2 ? std::stoi(argv[2]) : 7072;
+    double openness = argc > 3 ? std::stod(argv[3]) : 0.5;
+    int threads = argc > 4 ? std::stoi(argv[4])
+                           : std::max(1u, std::thread::hardware_concurrency());
+    runBFSBenchmark(size, openness, threads);
+    return 0;
+  }
+
   int M, N;
   std::cin >> M >> N;
   std::vector<std::vector<bool>> maze(M, std::vector<bool>(N));
@@ -139,9 +1163,13 @@ int main() {
     }
   }
 
+  // El backtracking se resuelve con la búsqueda en profundidad iterativa: mismo
+  // orden de movimientos, sin recursión ni riesgo de desbordar la pila
   std::vector<std::vector<bool>> solutionBacktracking;
-  double timeBacktracking = ExecutionTimer::measureExecutionTime(
-      [&]() { solutionBacktracking = solveMazeBacktracking(maze, M, N); });
+  BitGrid grid = toBitGrid(maze, M, N);
+  double timeBacktracking = ExecutionTimer::measureExecutionTime([&]() {
+    solutionBacktracking = toVectorMaze(solveMazeIterativeDFS(grid));
+  });
 
   std::vector<std::vector<bool>> solutionBranchAndBound;
   double timeBranchAndBound = ExecutionTimer::measureExecutionTime(
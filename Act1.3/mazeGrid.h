@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Rejilla plana de bits para los laberintos.
+ *
+ * Cada celda es un bit dentro de palabras de 64 bits. Alrededor del laberinto
+ * hay un borde de una celda que siempre vale 0, y cada fila ocupa un número
+ * entero de palabras (stride). Así la celda vecina en cualquier dirección está
+ * a un desplazamiento fijo del índice, y una pared o el borde se detectan con
+ * la misma prueba de bit, sin revisar límites.
+ *
+ * Se usa para las paredes (1 = celda libre), las marcas de visitado y la
+ * solución. DirectionGrid guarda el padre de cada celda como un código de
+ * dirección de 2 bits sobre los mismos índices, y AtomicBitGrid es la versión
+ * que varios hilos pueden marcar a la vez.
+ */
+class BitGrid {
+public:
+  BitGrid(int M, int N)
+      : M(M), N(N), stride((static_cast<size_t>(N) + 2 + 63) / 64 * 64),
+        words(stride * (static_cast<size_t>(M) + 2) / 64, 0) {}
+
+  int rows() const { return M; }
+  int cols() const { return N; }
+  size_t cells() const { return words.size() * 64; }
+
+  size_t index(int x, int y) const {
+    return static_cast<size_t>(x + 1) * stride + static_cast<size_t>(y + 1);
+  }
+  int rowOf(size_t i) const { return static_cast<int>(i / stride) - 1; }
+  int colOf(size_t i) const { return static_cast<int>(i % stride) - 1; }
+
+  // Desplazamiento del índice para cada movimiento, en el mismo orden que
+  // moves: {1, 0}, {0, 1}, {-1, 0}, {0, -1}
+  ptrdiff_t offset(int direction) const {
+    const ptrdiff_t row = static_cast<ptrdiff_t>(stride);
+    const ptrdiff_t offsets[4] = {row, 1, -row, -1};
+    return offsets[direction];
+  }
+
+  bool test(size_t i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+  void set(size_t i) { words[i >> 6] |= uint64_t(1) << (i & 63); }
+  void reset(size_t i) { words[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+
+  bool get(int x, int y) const { return test(index(x, y)); }
+  void set(int x, int y, bool value) {
+    value ? set(index(x, y)) : reset(index(x, y));
+  }
+
+  // Número de celdas en 1
+  size_t count() const {
+    size_t total = 0;
+    for (uint64_t word : words) {
+      total += std::popcount(word);
+    }
+    return total;
+  }
+
+  size_t memoryBytes() const { return words.size() * sizeof(uint64_t); }
+
+  // Acceso por palabra, para recorrer 64 celdas a la vez
+  size_t wordCount() const { return words.size(); }
+  uint64_t word(size_t w) const { return words[w]; }
+
+private:
+  int M, N;
+  size_t stride; // Bits por fila, múltiplo de 64
+  std::vector<uint64_t> words;
+};
+
+/**
+ * Código de dirección de 2 bits por celda (32 celdas por palabra), con los
+ * índices de una BitGrid del mismo tamaño
+ */
+class DirectionGrid {
+public:
+  explicit DirectionGrid(const BitGrid &grid)
+      : words((grid.cells() + 31) / 32, 0) {}
+
+  int get(size_t i) const { return (words[i >> 5] >> ((i & 31) * 2)) & 3; }
+  void set(size_t i, int direction) {
+    uint64_t shift = (i & 31) * 2;
+    words[i >> 5] =
+        (words[i >> 5] & ~(uint64_t(3) << shift)) | (uint64_t(direction) << shift);
+  }
+
+  size_t memoryBytes() const { return words.size() * sizeof(uint64_t); }
+
+private:
+  std::vector<uint64_t> words;
+};
+
+/**
+ * Bits atómicos con los índices de una BitGrid del mismo tamaño. claim marca
+ * una celda y dice si este hilo fue el que la marcó, así exactamente un hilo
+ * se queda con cada celda. Las operaciones son relaxed: el orden entre hilos
+ * lo dan las barreras del algoritmo que la usa.
+ */
+class AtomicBitGrid {
+public:
+  explicit AtomicBitGrid(const BitGrid &grid) : words(grid.wordCount()) {
+    clear(0, words.size());
+  }
+
+  bool test(size_t i) const {
+    return (words[i >> 6].load(std::memory_order_relaxed) >> (i & 63)) & 1;
+  }
+  bool claim(size_t i) {
+    uint64_t bit = uint64_t(1) << (i & 63);
+    if (words[i >> 6].load(std::memory_order_relaxed) & bit) {
+      return false;
+    }
+    return !(words[i >> 6].fetch_or(bit, std::memory_order_relaxed) & bit);
+  }
+
+  size_t wordCount() const { return words.size(); }
+  uint64_t word(size_t w) const {
+    return words[w].load(std::memory_order_relaxed);
+  }
+  void orWord(size_t w, uint64_t bits) {
+    words[w].fetch_or(bits, std::memory_order_relaxed);
+  }
+
+  // Limpia las palabras [begin, end)
+  void clear(size_t begin, size_t end) {
+    for (size_t w = begin; w < end; ++w) {
+      words[w].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  size_t memoryBytes() const { return words.size() * sizeof(uint64_t); }
+
+private:
+  std::vector<std::atomic<uint64_t>> words;
+};
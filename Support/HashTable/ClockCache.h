@@ -0,0 +1,228 @@
+#ifndef CLOCK_CACHE_H
+#define CLOCK_CACHE_H
+
+#include <vector>
+#include <cstddef>
+#include "FlatHashTable.h"
+
+// Capacity-bounded cache with the same API as FlatHashTable, meant to replace
+// an unbounded memo table in long-running processes.
+// It never holds more than `capacity` entries: once full, every new key evicts
+// an old one chosen by the CLOCK algorithm (an approximation of LRU). Each
+// entry has a "referenced" bit that is set on every hit; the clock hand sweeps
+// the entries, clearing set bits and evicting the first entry whose bit is
+// already clear, so recently used entries get a second chance.
+//
+// Memory grows with use and is bounded by the capacity: the key index starts
+// small and grows like any FlatHashTable, but evictions keep it at no more
+// than `capacity` keys, so it stops growing once the cache is full. A large
+// capacity therefore costs nothing for runs that only cache a few entries.
+template<typename K, typename V>
+class ClockCache {
+private:
+    struct Entry {
+        K key;
+        V value;
+        bool referenced;
+    };
+
+    FlatHashTable<K, size_t> index;   // key -> position in entries
+    std::vector<Entry> entries;       // Grows up to capacity, then slots are recycled
+    std::vector<size_t> freeEntries;  // Positions released by remove()
+    size_t capacity;
+    size_t hand;                      // Next entry the clock will inspect
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long evictions;
+
+    size_t acquireEntry();
+
+public:
+    explicit ClockCache(int capacity);
+    void insert(const K& key, const V& value);
+    template<typename Q = K>
+    bool remove(const Q& key);
+    template<typename Q = K>
+    bool get(const Q& key, V& value);
+    template<typename Q = K>
+    bool update(const Q& key, const V& value);
+    template<typename Q = K>
+    size_t hashKey(const Q& key) const;
+    template<typename Q = K>
+    bool findWithHash(const Q& key, size_t hash, V& value);
+    void insertWithHash(const K& key, size_t hash, const V& value);
+    int getSize() const;
+    int getCount() const;
+    double getCurrentLoadFactor() const;
+    unsigned long long getHits() const;
+    unsigned long long getMisses() const;
+    unsigned long long getEvictions() const;
+};
+
+// Implementation
+
+template<typename K, typename V>
+ClockCache<K, V>::ClockCache(int capacity)
+    : capacity(capacity > 0 ? capacity : 1), hand(0), hits(0), misses(0), evictions(0) {}
+// Time Complexity: O(1) - nothing is allocated until entries are inserted
+// Space Complexity: O(1); the index and entries grow with the number of cached keys
+
+template<typename K, typename V>
+size_t ClockCache<K, V>::acquireEntry() {
+    if (!freeEntries.empty()) {
+        size_t position = freeEntries.back();
+        freeEntries.pop_back();
+        return position;
+    }
+    if (entries.size() < capacity) {
+        entries.push_back(Entry());
+        return entries.size() - 1;
+    }
+
+    // Full: sweep until an entry without a second chance is found
+    while (entries[hand].referenced) {
+        entries[hand].referenced = false;
+        hand = (hand + 1) % capacity;
+    }
+    size_t victim = hand;
+    hand = (hand + 1) % capacity;
+
+    index.remove(entries[victim].key);
+    evictions++;
+    return victim;
+}
+// Time Complexity:
+// - Average case: O(1) - each sweep clears the bits it passes, so the hand
+//   moves at most c positions per c evictions (amortized O(1))
+// - Worst case: O(c) when every entry was referenced since the last sweep
+// Space Complexity: O(1)
+
+template<typename K, typename V>
+void ClockCache<K, V>::insert(const K& key, const V& value) {
+    insertWithHash(key, index.hashKey(key), value);
+}
+// Time Complexity: Amortized O(1)
+// Space Complexity: O(1) - bounded by the capacity
+
+template<typename K, typename V>
+void ClockCache<K, V>::insertWithHash(const K& key, size_t hash, const V& value) {
+    size_t position;
+    if (index.findWithHash(key, hash, position)) {
+        entries[position].value = value;
+        entries[position].referenced = true;
+        return;
+    }
+
+    position = acquireEntry();
+    entries[position].key = key;
+    entries[position].value = value;
+    entries[position].referenced = false; // New entries must earn their second chance
+    index.insertWithHash(key, hash, position);
+}
+// Time Complexity: Amortized O(1), without hashing the key
+// Space Complexity: O(1)
+
+template<typename K, typename V>
+template<typename Q>
+bool ClockCache<K, V>::remove(const Q& key) {
+    size_t position;
+    if (!index.get(key, position)) {
+        return false;
+    }
+    index.remove(key);
+    entries[position] = Entry();
+    freeEntries.push_back(position);
+    return true;
+}
+// Time Complexity: Average O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V>
+template<typename Q>
+bool ClockCache<K, V>::get(const Q& key, V& value) {
+    return findWithHash(key, index.hashKey(key), value);
+}
+// Time Complexity: Average O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V>
+template<typename Q>
+bool ClockCache<K, V>::findWithHash(const Q& key, size_t hash, V& value) {
+    size_t position;
+    if (!index.findWithHash(key, hash, position)) {
+        misses++;
+        return false;
+    }
+    hits++;
+    entries[position].referenced = true;
+    value = entries[position].value;
+    return true;
+}
+// Time Complexity: Average O(1), without hashing the key
+// Space Complexity: O(1)
+
+template<typename K, typename V>
+template<typename Q>
+bool ClockCache<K, V>::update(const Q& key, const V& value) {
+    size_t position;
+    if (!index.get(key, position)) {
+        return false;
+    }
+    entries[position].value = value;
+    entries[position].referenced = true;
+    return true;
+}
+// Time Complexity: Average O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V>
+template<typename Q>
+size_t ClockCache<K, V>::hashKey(const Q& key) const {
+    return index.hashKey(key);
+}
+// Time Complexity: O(1) for fixed-size keys, O(k) for strings of length k
+// Space Complexity: O(1)
+
+template<typename K, typename V>
+int ClockCache<K, V>::getSize() const {
+    return static_cast<int>(capacity);
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V>
+int ClockCache<K, V>::getCount() const {
+    return index.getCount();
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V>
+double ClockCache<K, V>::getCurrentLoadFactor() const {
+    return static_cast<double>(getCount()) / capacity;
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V>
+unsigned long long ClockCache<K, V>::getHits() const {
+    return hits;
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V>
+unsigned long long ClockCache<K, V>::getMisses() const {
+    return misses;
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V>
+unsigned long long ClockCache<K, V>::getEvictions() const {
+    return evictions;
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+#endif // CLOCK_CACHE_H
@@ -0,0 +1,261 @@
+#ifndef CONCURRENT_HASH_TABLE_H
+#define CONCURRENT_HASH_TABLE_H
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <vector>
+#include "FlatHashTable.h"
+
+// Thread-safe hash table made of SHARDS independent FlatHashTables.
+// A key always maps to the same shard, and each shard has its own
+// reader-writer lock, so threads working on different shards never contend
+// and readers of the same shard proceed in parallel.
+//
+// getOrCompute() lets several threads share one memo cache: the first thread
+// that asks for a missing key computes it, and every other thread asking for
+// the same key waits for that result instead of computing it again. The
+// computation runs without holding any lock, so it may recurse into the table.
+//
+// With LockFreeReads = true, get() first tries an optimistic read that takes
+// no lock at all (a per-shard sequence lock validates it afterwards). This
+// needs trivially copyable K and V, since a read racing with a writer may copy
+// a half-written entry before being discarded. To keep such reads memory-safe a
+// shard never reallocates the table readers may be looking at: it grows by
+// switching to a larger copy and keeps the old one alive until destruction.
+template<typename K, typename V, size_t SHARDS = 16, bool LockFreeReads = false>
+class ConcurrentHashTable {
+private:
+    static_assert(SHARDS > 0 && (SHARDS & (SHARDS - 1)) == 0, "SHARDS must be a power of two");
+    static constexpr int OPTIMISTIC_ATTEMPTS = 4;
+
+    struct alignas(64) Shard {  // One cache line per shard avoids false sharing between locks
+        mutable std::shared_mutex mutex;
+        std::atomic<uint64_t> version{0};                      // Odd while a writer is mutating
+        std::atomic<FlatHashTable<K, V>*> current{nullptr};
+        std::vector<std::unique_ptr<FlatHashTable<K, V>>> generations; // Retired tables (LockFreeReads)
+        FlatHashTable<K, std::shared_future<V>> inFlight;      // Keys being computed right now
+    };
+
+    Shard shards[SHARDS];
+
+    static size_t shardIndex(const K& key);
+    Shard& shardFor(const K& key) { return shards[shardIndex(key)]; }
+    const Shard& shardFor(const K& key) const { return shards[shardIndex(key)]; }
+    bool getOptimistic(const Shard& shard, const K& key, V& value) const;
+    void insertLocked(Shard& shard, const K& key, const V& value);
+
+public:
+    ConcurrentHashTable();
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    void insert(const K& key, const V& value);
+    bool remove(const K& key);
+    bool get(const K& key, V& value) const;
+    bool update(const K& key, const V& value);
+    template<typename Func>
+    V getOrCompute(const K& key, Func compute);
+    int getSize() const;
+    int getCount() const;
+};
+
+// Implementation
+
+template<typename K, typename V, size_t SHARDS, bool LockFreeReads>
+ConcurrentHashTable<K, V, SHARDS, LockFreeReads>::ConcurrentHashTable() {
+    for (Shard& shard : shards) {
+        shard.generations.push_back(std::make_unique<FlatHashTable<K, V>>());
+        shard.current.store(shard.generations.back().get(), std::memory_order_release);
+    }
+}
+// Time Complexity: O(SHARDS)
+// Space Complexity: O(SHARDS)
+
+template<typename K, typename V, size_t SHARDS, bool LockFreeReads>
+size_t ConcurrentHashTable<K, V, SHARDS, LockFreeReads>::shardIndex(const K& key) {
+    // Same hash and multiply as the shard tables (FlatHashTable::homeIndex), but
+    // the tables take the top bits of the product for the home slot and the 7
+    // below them for the fingerprint, so the shard takes the lowest bits. Since
+    // the bit ranges are disjoint, every key in a shard still spreads over the
+    // whole shard table. The multiplier is odd, so the low bits of the product
+    // are a permutation of the hash's low bits, which WyHasher mixes well.
+    uint64_t h = static_cast<uint64_t>(WyHasher<K>{}(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(h & (SHARDS - 1));
+}
+// Time Complexity: O(1) for fixed-size keys, O(k) for strings of length k
+// Space Complexity: O(1)
+
+template<typename K, typename V, size_t SHARDS, bool LockFreeReads>
+bool ConcurrentHashTable<K, V, SHARDS, LockFreeReads>::getOptimistic(const Shard& shard, const K& key, V& value) const {
+    static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                  "LockFreeReads requires trivially copyable keys and values");
+
+    for (int attempt = 0; attempt < OPTIMISTIC_ATTEMPTS; ++attempt) {
+        uint64_t before = shard.version.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue; // A writer is in the middle of a change
+        }
+        V candidate;
+        bool found = shard.current.load(std::memory_order_acquire)->get(key, candidate);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (shard.version.load(std::memory_order_relaxed) == before) {
+            if (found) {
+                value = candidate;
+            }
+            return found;
+        }
+    }
+
+    // Too much write traffic on this shard: fall back to the shared lock
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.current.load(std::memory_order_relaxed)->get(key, value);
+}
+// Time Complexity: Average O(1); retries are bounded by OPTIMISTIC_ATTEMPTS
+// Space Complexity: O(1)
+
+template<typename K, typename V, size_t SHARDS, bool LockFreeReads>
+void ConcurrentHashTable<K, V, SHARDS, LockFreeReads>::insertLocked(Shard& shard, const K& key, const V& value) {
+    FlatHashTable<K, V>* table = shard.current.load(std::memory_order_relaxed);
+
+    if (LockFreeReads && !table->fitsWithoutResize(key)) {
+        // Readers may be inside *table, so grow into a copy and retire the original
+        auto grown = std::make_unique<FlatHashTable<K, V>>(*table);
+        grown->reserve(grown->getCount() * 2 + 1);
+        grown->insert(key, value);
+        shard.current.store(grown.get(), std::memory_order_release);
+        shard.generations.push_back(std::move(grown));
+        return;
+    }
+
+    shard.version.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    table->insert(key, value);
+    shard.version.fetch_add(1, std::memory_order_release);
+}
+// Time Complexity: Amortized O(1); a growth step copies the shard in O(n / SHARDS)
+// Space Complexity: O(1), or O(n / SHARDS) for the retained generation when growing
+
+template<typename K, typename V, size_t SHARDS, bool LockFreeReads>
+void ConcurrentHashTable<K, V, SHARDS, LockFreeReads>::insert(const K& key, const V& value) {
+    Shard& shard = shardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    insertLocked(shard, key, value);
+}
+// Time Complexity: Amortized O(1) plus lock acquisition
+// Space Complexity: O(1)
+
+template<typename K, typename V, size_t SHARDS, bool LockFreeReads>
+bool ConcurrentHashTable<K, V, SHARDS, LockFreeReads>::remove(const K& key) {
+    Shard& shard = shardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.version.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bool removed = shard.current.load(std::memory_order_relaxed)->remove(key);
+    shard.version.fetch_add(1, std::memory_order_release);
+    return removed;
+}
+// Time Complexity: Average O(1) plus lock acquisition
+// Space Complexity: O(1)
+
+template<typename K, typename V, size_t SHARDS, bool LockFreeReads>
+bool ConcurrentHashTable<K, V, SHARDS, LockFreeReads>::get(const K& key, V& value) const {
+    const Shard& shard = shardFor(key);
+    if constexpr (LockFreeReads) {
+        return getOptimistic(shard, key, value);
+    } else {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.current.load(std::memory_order_relaxed)->get(key, value);
+    }
+}
+// Time Complexity: Average O(1); readers of the same shard do not block each other
+// Space Complexity: O(1)
+
+template<typename K, typename V, size_t SHARDS, bool LockFreeReads>
+bool ConcurrentHashTable<K, V, SHARDS, LockFreeReads>::update(const K& key, const V& value) {
+    Shard& shard = shardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.version.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bool updated = shard.current.load(std::memory_order_relaxed)->update(key, value);
+    shard.version.fetch_add(1, std::memory_order_release);
+    return updated;
+}
+// Time Complexity: Average O(1) plus lock acquisition
+// Space Complexity: O(1)
+
+template<typename K, typename V, size_t SHARDS, bool LockFreeReads>
+template<typename Func>
+V ConcurrentHashTable<K, V, SHARDS, LockFreeReads>::getOrCompute(const K& key, Func compute) {
+    V value;
+    if (get(key, value)) {
+        return value;
+    }
+
+    Shard& shard = shardFor(key);
+    std::promise<V> promise;
+    std::shared_future<V> pending;
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (shard.current.load(std::memory_order_relaxed)->get(key, value)) {
+            return value; // Another thread finished it while we waited for the lock
+        }
+        if (shard.inFlight.get(key, pending)) {
+            lock.unlock();
+            return pending.get(); // Someone else is computing it: wait for their result
+        }
+        pending = promise.get_future().share();
+        shard.inFlight.insert(key, pending);
+    }
+
+    // We own the computation. No lock is held, so compute() may call back into the table.
+    try {
+        value = compute();
+    } catch (...) {
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.inFlight.remove(key);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        insertLocked(shard, key, value);
+        shard.inFlight.remove(key);
+    }
+    promise.set_value(value);
+    return value;
+}
+// Time Complexity: O(1) on a hit; otherwise the cost of compute(), paid once per key
+// Space Complexity: O(1) extra while the key is in flight
+
+template<typename K, typename V, size_t SHARDS, bool LockFreeReads>
+int ConcurrentHashTable<K, V, SHARDS, LockFreeReads>::getSize() const {
+    int total = 0;
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.current.load(std::memory_order_relaxed)->getSize();
+    }
+    return total;
+}
+// Time Complexity: O(SHARDS)
+// Space Complexity: O(1)
+
+template<typename K, typename V, size_t SHARDS, bool LockFreeReads>
+int ConcurrentHashTable<K, V, SHARDS, LockFreeReads>::getCount() const {
+    int total = 0;
+    for (const Shard& shard : shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        total += shard.current.load(std::memory_order_relaxed)->getCount();
+    }
+    return total;
+}
+// Time Complexity: O(SHARDS)
+// Space Complexity: O(1)
+
+#endif // CONCURRENT_HASH_TABLE_H
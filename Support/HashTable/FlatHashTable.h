@@ -0,0 +1,992 @@
+#ifndef FLAT_HASH_TABLE_H
+#define FLAT_HASH_TABLE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <memory>
+#include <span>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Hashers.h"
+
+// Group probing compares GROUP_WIDTH control bytes at once. SSE2 is part of the
+// x86-64 baseline, so the SIMD path is the default there; any other target (or
+// -DFLAT_HASH_TABLE_NO_SIMD) uses the portable scalar loop.
+#if defined(__SSE2__) && !defined(FLAT_HASH_TABLE_NO_SIMD)
+#include <emmintrin.h>
+#define FLAT_HASH_TABLE_SSE2 1
+#endif
+
+// Open-addressing hash table with the same API as HashTable.
+// Entries live in one flat array (no per-entry heap node). Collisions are
+// resolved with Robin Hood linear probing: an entry that is further from its
+// home slot steals the place of an entry that is closer to its own, which keeps
+// probe sequences short and lets lookups stop early on a miss.
+// Deletion uses backward shifting, so the table never accumulates tombstones.
+//
+// Next to every slot there is a control byte holding either CTRL_EMPTY or a
+// 7-bit fingerprint of the key's hash. Lookups scan 16 control bytes per step
+// and only compare keys whose fingerprint matches, so a miss usually touches no
+// key at all. Because Robin Hood keeps every run free of holes, a lookup can
+// stop at the first empty control byte after the key's home slot.
+//
+// Every slot also keeps the full hash of its key: resizing moves entries
+// without hashing a single key again, and most failed key comparisons are
+// settled by comparing hashes. Lookups accept any key type that hashes like K
+// (for std::string keys that is std::string_view or a string literal), and
+// hashKey() + findWithHash()/insertWithHash() let a caller hash a key once and
+// reuse it for a lookup followed by an insert.
+//
+// With setIncrementalResize(true), growing no longer rehashes everything in
+// one call. The old arrays are kept next to the new ones and every insert,
+// update or remove moves the next MIGRATION_STEP slots across, so no single
+// operation pays O(n). Lookups check both arrays until the move is complete.
+//
+// Tables with trivially copyable K and V can be written to disk with save()
+// and brought back with openMapped(). The file is the slot and metadata arrays
+// exactly as they sit in memory, addressed by offsets only, so openMapped()
+// just mmaps it read-only and probes it in place: no entry is parsed or copied.
+// A warm process can consult the mapped table before computing anything and
+// keep new results in an ordinary FlatHashTable.
+//
+// insertBatch() and getBatch() handle long runs of independent keys. They hash
+// BATCH_CHUNK keys first and prefetch each key's home slot, then resolve them,
+// so the cache misses of one chunk overlap instead of being paid one by one.
+//
+// The hash function is the Hasher parameter (see Hashers.h): WyHasher by
+// default, StdHasher for the cheapest possible hash, or Sha3Hasher when keys
+// may be chosen by an adversary. Whatever it returns, a hash is reduced to a
+// slot with multiply-shift (Fibonacci hashing): the hash is multiplied by
+// 2^64 / phi and the top log2(capacity) bits are the home slot. That costs one
+// multiply instead of a division and, unlike masking the low bits, gives even
+// weak hashes such as the identity std::hash<int> a good spread. The 7
+// fingerprint bits are the ones right below the slot bits.
+template<typename K, typename V, typename Hasher = WyHasher<K>>
+class FlatHashTable {
+private:
+    static constexpr int INITIAL_SIZE = 16;          // Always a power of two
+    static constexpr double LOAD_FACTOR = 0.80;
+    static constexpr uint8_t EMPTY = 0;              // distances[i] == EMPTY means the slot is free
+    static constexpr uint8_t MAX_DISTANCE = 255;     // Longest probe distance a slot can record
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+    static constexpr size_t GROUP_WIDTH = 16;        // Control bytes matched per probe step
+    static constexpr uint8_t CTRL_EMPTY = 0x80;      // Fingerprints only use the low 7 bits
+    static constexpr size_t MIGRATION_STEP = 8;      // Old slots visited per operation while resizing
+    static constexpr size_t BATCH_CHUNK = 16;        // Keys hashed and prefetched ahead in batch calls
+    static constexpr uint64_t FIBONACCI = 0x9E3779B97F4A7C15ULL; // 2^64 / golden ratio, odd
+
+    struct Slot {
+        K key;
+        V value;
+        size_t hash;
+    };
+
+    // Header of a saved image; every array is located by its byte offset
+    struct ImageHeader {
+        char magic[8];
+        uint32_t formatVersion;
+        uint32_t slotSize;
+        uint32_t keySize;
+        uint32_t valueSize;
+        uint64_t capacity;
+        uint64_t count;
+        uint64_t slotsOffset;
+        uint64_t distancesOffset;
+        uint64_t controlOffset;
+        uint64_t fileSize;
+        uint64_t hasherCheck;   // Hash of K() under the saving table's hasher
+    };
+    static constexpr char IMAGE_MAGIC[8] = {'F', 'L', 'A', 'T', 'H', 'T', 'B', 'L'};
+    static constexpr uint32_t IMAGE_FORMAT_VERSION = 2;
+
+    // One set of open-addressing arrays. The table normally has one; during an
+    // incremental resize it has two (current and previous).
+    // Slots are default-initialized rather than zero-filled: only the slots
+    // whose distance is non-zero are ever read, and skipping the fill keeps
+    // allocating a large table (e.g. when an incremental resize starts) cheap.
+    struct Storage {
+        std::unique_ptr<Slot[]> slots;
+        std::vector<uint8_t> distances; // 0 = empty, otherwise probe distance + 1
+        std::vector<uint8_t> control;   // Fingerprint per slot, plus GROUP_WIDTH - 1 cloned bytes
+                                        // of the start so a group load never wraps around
+        size_t mask;                    // capacity - 1
+        unsigned shift;                 // 64 - log2(capacity), for multiply-shift
+        size_t count;
+
+        Storage() : mask(0), shift(63), count(0) {}
+        explicit Storage(size_t capacity);
+        Storage(const Storage& other);
+        Storage(Storage&& other) = default;
+        Storage& operator=(Storage other);
+        size_t capacity() const { return distances.size(); }
+        size_t homeIndex(size_t hash) const { return FlatHashTable::homeIndex(hash, shift); }
+        void setControl(size_t index, uint8_t value);
+        template<typename Q>
+        size_t findIndex(const Q& key, size_t hash) const;
+        bool place(K& key, V& value, size_t& hash);
+        void erase(size_t index);
+    };
+
+    [[no_unique_address]] Hasher hasher;
+    Storage current;
+    Storage previous;        // Entries an incremental resize has not moved yet
+    size_t maxCount;         // count that triggers the next resize
+    bool incremental;
+    bool migrating;
+    size_t migrationCursor;  // Next slot of previous to move
+    size_t migrationLeft;    // Slots of previous still to visit
+
+    static size_t homeIndex(size_t hash, unsigned shift);
+    static uint8_t fingerprint(size_t hash, unsigned shift);
+    static unsigned shiftFor(size_t capacity);
+    static uint32_t matchGroup(const uint8_t* group, uint8_t fingerprint, uint32_t& empties);
+    template<typename Q>
+    static size_t probe(const Slot* slots, const uint8_t* control, size_t mask, unsigned shift,
+                        const Q& key, size_t hash);
+    void prefetch(size_t hash) const;
+    void placeNew(K key, V value, size_t hash);
+    void resize(size_t newCapacity);
+    void startMigration(size_t newCapacity);
+    void migrate(size_t budget);
+    template<typename Q>
+    bool locate(const Q& key, size_t hash, Storage*& storage, size_t& index);
+    template<typename Q>
+    bool locate(const Q& key, size_t hash, const Storage*& storage, size_t& index) const;
+
+public:
+    // Read-only table backed by a file mapped with openMapped()
+    class Mapped {
+    public:
+        Mapped(Mapped&& other) noexcept;
+        Mapped(const Mapped&) = delete;
+        Mapped& operator=(const Mapped&) = delete;
+        ~Mapped();
+        template<typename Q = K>
+        bool get(const Q& key, V& value) const;
+        template<typename Q = K>
+        bool findWithHash(const Q& key, size_t hash, V& value) const;
+        int getSize() const;
+        int getCount() const;
+
+    private:
+        friend class FlatHashTable;
+        Mapped(void* base, size_t length, const Hasher& hasher);
+
+        [[no_unique_address]] Hasher hasher;
+        void* base;
+        size_t length;
+        const Slot* slots;
+        const uint8_t* control;
+        size_t mask;
+        unsigned shift;
+        size_t count;
+    };
+
+    explicit FlatHashTable(const Hasher& hasher = Hasher());
+    void insert(const K& key, const V& value);
+    template<typename Q = K>
+    bool remove(const Q& key);
+    template<typename Q = K>
+    bool get(const Q& key, V& value) const;
+    template<typename Q = K>
+    bool update(const Q& key, const V& value);
+    template<typename Q = K>
+    size_t hashKey(const Q& key) const;
+    template<typename Q = K>
+    bool findWithHash(const Q& key, size_t hash, V& value) const;
+    void insertWithHash(const K& key, size_t hash, const V& value);
+    void insertBatch(std::span<const std::pair<K, V>> entries);
+    int getBatch(std::span<const K> keys, std::span<V> values, std::span<bool> found) const;
+    int getSize() const;
+    int getCount() const;
+    double getCurrentLoadFactor() const;
+    double getAverageProbeDistance() const;
+    void reserve(int expectedCount);
+    bool fitsWithoutResize(const K& key) const;
+    void setIncrementalResize(bool enabled);
+    bool isResizing() const;
+    void save(const std::string& path) const;
+    static Mapped openMapped(const std::string& path, const Hasher& hasher = Hasher());
+};
+
+// Implementation
+
+template<typename K, typename V, typename Hasher>
+FlatHashTable<K, V, Hasher>::Storage::Storage(size_t capacity)
+    : slots(new Slot[capacity]), distances(capacity, EMPTY), control(capacity + GROUP_WIDTH - 1, CTRL_EMPTY),
+      mask(capacity - 1), shift(shiftFor(capacity)), count(0) {
+}
+// Time Complexity: O(m) where m is the capacity, but only the 2 bytes of metadata per
+// slot are written when K and V are trivially constructible
+// Space Complexity: O(m)
+
+template<typename K, typename V, typename Hasher>
+FlatHashTable<K, V, Hasher>::Storage::Storage(const Storage& other)
+    : slots(other.slots ? new Slot[other.capacity()] : nullptr), distances(other.distances),
+      control(other.control), mask(other.mask), shift(other.shift), count(other.count) {
+    for (size_t i = 0; i < capacity(); ++i) {
+        if (distances[i] != EMPTY) {
+            slots[i] = other.slots[i];
+        }
+    }
+}
+// Time Complexity: O(m)
+// Space Complexity: O(m)
+
+template<typename K, typename V, typename Hasher>
+typename FlatHashTable<K, V, Hasher>::Storage& FlatHashTable<K, V, Hasher>::Storage::operator=(Storage other) {
+    std::swap(slots, other.slots);
+    std::swap(distances, other.distances);
+    std::swap(control, other.control);
+    std::swap(mask, other.mask);
+    std::swap(shift, other.shift);
+    std::swap(count, other.count);
+    return *this;
+}
+// Time Complexity: O(1) beyond the copy or move that built the argument
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+FlatHashTable<K, V, Hasher>::FlatHashTable(const Hasher& hasher)
+    : hasher(hasher), current(INITIAL_SIZE), maxCount(static_cast<size_t>(INITIAL_SIZE * LOAD_FACTOR)),
+      incremental(false), migrating(false), migrationCursor(0), migrationLeft(0) {
+}
+// Time Complexity: O(m) where m is the initial capacity
+// Space Complexity: O(m)
+
+template<typename K, typename V, typename Hasher>
+template<typename Q>
+size_t FlatHashTable<K, V, Hasher>::hashKey(const Q& key) const {
+    // Hashers of std::string keys take std::string_view, so views and literals
+    // find std::string keys without building a string
+    return static_cast<size_t>(hasher(key));
+}
+// Time Complexity: O(1) for fixed-size keys, O(k) for strings of length k
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+size_t FlatHashTable<K, V, Hasher>::homeIndex(size_t hash, unsigned shift) {
+    return static_cast<size_t>((static_cast<uint64_t>(hash) * FIBONACCI) >> shift);
+}
+// Time Complexity: O(1) - one multiply and one shift
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+uint8_t FlatHashTable<K, V, Hasher>::fingerprint(size_t hash, unsigned shift) {
+    // The top bits of the product pick the home slot; the next 7 tell apart the
+    // keys that share it
+    return static_cast<uint8_t>(((static_cast<uint64_t>(hash) * FIBONACCI) >> (shift - 7)) & 0x7F);
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+unsigned FlatHashTable<K, V, Hasher>::shiftFor(size_t capacity) {
+    return 64 - static_cast<unsigned>(__builtin_ctzll(capacity));
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+uint32_t FlatHashTable<K, V, Hasher>::matchGroup(const uint8_t* group, uint8_t fingerprint, uint32_t& empties) {
+#ifdef FLAT_HASH_TABLE_SSE2
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    // CTRL_EMPTY is the only value with the high bit set, so movemask finds empties directly
+    empties = static_cast<uint32_t>(_mm_movemask_epi8(bytes));
+    __m128i matches = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(fingerprint)));
+    return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+#else
+    uint32_t matches = 0;
+    empties = 0;
+    for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+        matches |= static_cast<uint32_t>(group[i] == fingerprint) << i;
+        empties |= static_cast<uint32_t>(group[i] == CTRL_EMPTY) << i;
+    }
+    return matches;
+#endif
+}
+// Time Complexity: O(1) - one 16-byte compare (or 16 scalar compares)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+void FlatHashTable<K, V, Hasher>::Storage::setControl(size_t index, uint8_t value) {
+    control[index] = value;
+    if (index < GROUP_WIDTH - 1) {
+        control[capacity() + index] = value; // Keep the cloned tail in sync
+    }
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+template<typename Q>
+size_t FlatHashTable<K, V, Hasher>::Storage::findIndex(const Q& key, size_t h) const {
+    return probe(slots.get(), control.data(), mask, shift, key, h);
+}
+// Time Complexity: Average O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+template<typename Q>
+size_t FlatHashTable<K, V, Hasher>::probe(const Slot* slots, const uint8_t* control, size_t mask, unsigned shift,
+                                          const Q& key, size_t h) {
+    uint8_t fp = fingerprint(h, shift);
+    size_t index = homeIndex(h, shift);
+
+    for (size_t probed = 0; probed <= mask; probed += GROUP_WIDTH) {
+        uint32_t empties;
+        uint32_t matches = matchGroup(&control[index], fp, empties);
+        if (empties != 0) {
+            // Runs have no holes: nothing for this key lies past the first empty slot
+            matches &= (empties & (0u - empties)) - 1;
+        }
+
+        while (matches != 0) {
+            size_t candidate = (index + __builtin_ctz(matches)) & mask;
+            if (slots[candidate].hash == h && slots[candidate].key == key) {
+                return candidate;
+            }
+            matches &= matches - 1;
+        }
+
+        if (empties != 0) {
+            return NOT_FOUND;
+        }
+        index = (index + GROUP_WIDTH) & mask;
+    }
+    return NOT_FOUND;
+}
+// Time Complexity:
+// - Average case: O(1) - usually a single group; misses rarely compare a key
+// - Worst case: O(MAX_DISTANCE / GROUP_WIDTH) groups
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+bool FlatHashTable<K, V, Hasher>::Storage::place(K& key, V& value, size_t& h) {
+    size_t index = homeIndex(h);
+    uint8_t distance = 1;
+    uint8_t fp = fingerprint(h, shift);
+
+    while (true) {
+        if (distances[index] == EMPTY) {
+            slots[index].key = std::move(key);
+            slots[index].value = std::move(value);
+            slots[index].hash = h;
+            distances[index] = distance;
+            setControl(index, fp);
+            count++;
+            return true;
+        }
+
+        // Robin Hood: take the slot from a "richer" entry and carry it forward
+        if (distances[index] < distance) {
+            std::swap(slots[index].key, key);
+            std::swap(slots[index].value, value);
+            std::swap(slots[index].hash, h);
+            std::swap(distances[index], distance);
+            uint8_t displaced = control[index];
+            setControl(index, fp);
+            fp = displaced;
+        }
+
+        index = (index + 1) & mask;
+        if (++distance == MAX_DISTANCE) {
+            return false; // key, value and h now hold the entry that is still homeless
+        }
+    }
+}
+// Time Complexity: Average O(1), worst O(MAX_DISTANCE)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+void FlatHashTable<K, V, Hasher>::Storage::erase(size_t index) {
+    // Backward shift: pull every following displaced entry one slot closer to
+    // its home until we reach an empty slot or an entry already at home.
+    size_t next = (index + 1) & mask;
+    while (distances[next] > 1) {
+        slots[index] = std::move(slots[next]);
+        distances[index] = distances[next] - 1;
+        setControl(index, control[next]);
+        index = next;
+        next = (next + 1) & mask;
+    }
+
+    slots[index] = Slot();
+    distances[index] = EMPTY;
+    setControl(index, CTRL_EMPTY);
+    count--;
+}
+// Time Complexity:
+// - Average case: O(1) - the shifted run is as short as a probe sequence
+// - Worst case: O(MAX_DISTANCE)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+void FlatHashTable<K, V, Hasher>::placeNew(K key, V value, size_t h) {
+    if (!current.place(key, value, h)) {
+        // Pathological clustering: grow right away and place the carried entry again
+        resize(current.capacity() * 2);
+        placeNew(std::move(key), std::move(value), h);
+    }
+}
+// Time Complexity:
+// - Average case: O(1)
+// - Worst case: O(n) when the probe limit forces a resize
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+void FlatHashTable<K, V, Hasher>::resize(size_t newCapacity) {
+    if (migrating) {
+        migrate(previous.capacity()); // Finish the pending move first
+    }
+
+    Storage old(newCapacity);
+    std::swap(old, current);
+    maxCount = static_cast<size_t>(newCapacity * LOAD_FACTOR);
+
+    for (size_t i = 0; i < old.capacity(); ++i) {
+        if (old.distances[i] != EMPTY) {
+            // The stored hash is reused: no key is hashed again
+            placeNew(std::move(old.slots[i].key), std::move(old.slots[i].value), old.slots[i].hash);
+        }
+    }
+}
+// Time Complexity: O(n) where n is the number of elements in the table
+// Space Complexity: O(m) where m is the new capacity (usually 2 * original capacity)
+
+template<typename K, typename V, typename Hasher>
+void FlatHashTable<K, V, Hasher>::startMigration(size_t newCapacity) {
+    previous = Storage(newCapacity);
+    std::swap(previous, current);
+    maxCount = static_cast<size_t>(newCapacity * LOAD_FACTOR);
+
+    // Start on an empty slot, so that every step can stop between two runs
+    migrationCursor = 0;
+    while (previous.distances[migrationCursor] != EMPTY) {
+        migrationCursor++;
+    }
+    migrationLeft = previous.capacity();
+    migrating = true;
+}
+// Time Complexity: O(m) to allocate the new arrays; no entry is moved here
+// Space Complexity: O(m) where m is the new capacity
+
+template<typename K, typename V, typename Hasher>
+void FlatHashTable<K, V, Hasher>::migrate(size_t budget) {
+    // Old slots are emptied without backward shifting, which would break lookups
+    // for the rest of their run. To keep previous a valid Robin Hood table, a
+    // step only stops on a slot that was already empty, i.e. between two runs:
+    // every run is then either fully moved or untouched.
+    size_t visited = 0;
+    while (migrationLeft > 0) {
+        size_t index = migrationCursor;
+        if (previous.distances[index] == EMPTY) {
+            if (visited >= budget) {
+                return;
+            }
+        } else {
+            Slot moved = std::move(previous.slots[index]);
+            previous.slots[index] = Slot();
+            previous.distances[index] = EMPTY;
+            previous.setControl(index, CTRL_EMPTY);
+            previous.count--;
+
+            placeNew(std::move(moved.key), std::move(moved.value), moved.hash);
+            if (!migrating) {
+                return; // placeNew had to grow, which already finished the move
+            }
+        }
+        migrationCursor = (migrationCursor + 1) & previous.mask;
+        migrationLeft--;
+        visited++;
+    }
+
+    previous = Storage();
+    migrating = false;
+}
+// Time Complexity: O(budget) plus the rest of the current run, amortized O(1) per operation
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+template<typename Q>
+bool FlatHashTable<K, V, Hasher>::locate(const Q& key, size_t hash, Storage*& storage, size_t& index) {
+    const Storage* found;
+    if (!static_cast<const FlatHashTable*>(this)->locate(key, hash, found, index)) {
+        return false;
+    }
+    storage = const_cast<Storage*>(found);
+    return true;
+}
+// Time Complexity: Average O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+template<typename Q>
+bool FlatHashTable<K, V, Hasher>::locate(const Q& key, size_t hash, const Storage*& storage, size_t& index) const {
+    index = current.findIndex(key, hash);
+    if (index != NOT_FOUND) {
+        storage = &current;
+        return true;
+    }
+    if (migrating) {
+        index = previous.findIndex(key, hash);
+        if (index != NOT_FOUND) {
+            storage = &previous;
+            return true;
+        }
+    }
+    return false;
+}
+// Time Complexity: Average O(1); two probes while an incremental resize is running
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+void FlatHashTable<K, V, Hasher>::insert(const K& key, const V& value) {
+    insertWithHash(key, hashKey(key), value);
+}
+// Time Complexity:
+// - Average case: O(1)
+// - Amortized: O(1) due to occasional resizing
+// - With incremental resize no single call pays O(n)
+// Space Complexity: O(1) - the entry is stored inline in the slot array
+
+template<typename K, typename V, typename Hasher>
+void FlatHashTable<K, V, Hasher>::insertWithHash(const K& key, size_t hash, const V& value) {
+    Storage* storage;
+    size_t index;
+    if (locate(key, hash, storage, index)) {
+        storage->slots[index].value = value;
+        return;
+    }
+
+    if (current.count + previous.count + 1 > maxCount) {
+        if (incremental && !migrating) {
+            startMigration(current.capacity() * 2);
+        } else {
+            resize(current.capacity() * 2);
+        }
+    }
+    placeNew(key, value, hash);
+
+    if (migrating) {
+        migrate(MIGRATION_STEP);
+    }
+}
+// Time Complexity: Same as insert, without hashing the key
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+template<typename Q>
+bool FlatHashTable<K, V, Hasher>::remove(const Q& key) {
+    Storage* storage;
+    size_t index;
+    if (!locate(key, hashKey(key), storage, index)) {
+        return false;
+    }
+
+    // In previous, a backward shift stops at the latest empty slot, so it never
+    // crosses the run boundary the migration cursor is waiting on
+    storage->erase(index);
+    if (migrating) {
+        migrate(MIGRATION_STEP);
+    }
+    return true;
+}
+// Time Complexity:
+// - Average case: O(1) - the shifted run is as short as a probe sequence
+// - Worst case: O(MAX_DISTANCE)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+template<typename Q>
+bool FlatHashTable<K, V, Hasher>::get(const Q& key, V& value) const {
+    return findWithHash(key, hashKey(key), value);
+}
+// Time Complexity: Average O(1), worst O(MAX_DISTANCE)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+template<typename Q>
+bool FlatHashTable<K, V, Hasher>::findWithHash(const Q& key, size_t hash, V& value) const {
+    const Storage* storage;
+    size_t index;
+    if (!locate(key, hash, storage, index)) {
+        return false;
+    }
+    value = storage->slots[index].value;
+    return true;
+}
+// Time Complexity: Average O(1), worst O(MAX_DISTANCE); the key is not hashed
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+template<typename Q>
+bool FlatHashTable<K, V, Hasher>::update(const Q& key, const V& value) {
+    Storage* storage;
+    size_t index;
+    if (!locate(key, hashKey(key), storage, index)) {
+        return false;
+    }
+    storage->slots[index].value = value;
+    if (migrating) {
+        migrate(MIGRATION_STEP);
+    }
+    return true;
+}
+// Time Complexity: Average O(1), worst O(MAX_DISTANCE)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+int FlatHashTable<K, V, Hasher>::getSize() const {
+    return static_cast<int>(current.capacity());
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+int FlatHashTable<K, V, Hasher>::getCount() const {
+    return static_cast<int>(current.count + previous.count);
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+double FlatHashTable<K, V, Hasher>::getCurrentLoadFactor() const {
+    return static_cast<double>(getCount()) / current.capacity();
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+double FlatHashTable<K, V, Hasher>::getAverageProbeDistance() const {
+    // How far entries sit from their home slot: 0 means no key collided at all
+    size_t total = 0;
+    for (const Storage* storage : {&current, &previous}) {
+        for (uint8_t distance : storage->distances) {
+            if (distance != EMPTY) {
+                total += distance - 1;
+            }
+        }
+    }
+    size_t entries = current.count + previous.count;
+    return entries == 0 ? 0.0 : static_cast<double>(total) / entries;
+}
+// Time Complexity: O(m) where m is the capacity
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+void FlatHashTable<K, V, Hasher>::reserve(int expectedCount) {
+    size_t newCapacity = current.capacity();
+    while (static_cast<size_t>(newCapacity * LOAD_FACTOR) < static_cast<size_t>(expectedCount)) {
+        newCapacity *= 2;
+    }
+    if (newCapacity != current.capacity()) {
+        resize(newCapacity);
+    }
+}
+// Time Complexity: O(n + m) where m is the new capacity, paid once instead of per doubling
+// Space Complexity: O(m)
+
+template<typename K, typename V, typename Hasher>
+bool FlatHashTable<K, V, Hasher>::fitsWithoutResize(const K& key) const {
+    const Storage* storage;
+    size_t index;
+    size_t h = hashKey(key);
+    if (locate(key, h, storage, index)) {
+        return true; // insert() would only overwrite the value
+    }
+    if (migrating || current.count + 1 > maxCount) {
+        return false;
+    }
+
+    // Replay the Robin Hood walk of Storage::place without moving anything, to
+    // see whether the carried entry would hit MAX_DISTANCE before an empty slot.
+    index = current.homeIndex(h);
+    uint8_t distance = 1;
+    while (current.distances[index] != EMPTY) {
+        if (current.distances[index] < distance) {
+            distance = current.distances[index];
+        }
+        index = (index + 1) & current.mask;
+        if (++distance == MAX_DISTANCE) {
+            return false;
+        }
+    }
+    return true;
+}
+// Time Complexity: Average O(1), worst O(MAX_DISTANCE)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+void FlatHashTable<K, V, Hasher>::setIncrementalResize(bool enabled) {
+    incremental = enabled;
+    if (!enabled && migrating) {
+        migrate(previous.capacity());
+    }
+}
+// Time Complexity: O(1), or O(n) if a pending incremental resize has to be finished
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+bool FlatHashTable<K, V, Hasher>::isResizing() const {
+    return migrating;
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+void FlatHashTable<K, V, Hasher>::prefetch(size_t hash) const {
+    size_t index = current.homeIndex(hash);
+    __builtin_prefetch(&current.control[index]);
+    __builtin_prefetch(&current.slots[index]);
+}
+// Time Complexity: O(1) - a hint only, nothing is waited for
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+void FlatHashTable<K, V, Hasher>::insertBatch(std::span<const std::pair<K, V>> entries) {
+    size_t hashes[BATCH_CHUNK];
+    for (size_t start = 0; start < entries.size(); start += BATCH_CHUNK) {
+        size_t chunk = std::min(BATCH_CHUNK, entries.size() - start);
+
+        for (size_t i = 0; i < chunk; ++i) {
+            hashes[i] = hashKey(entries[start + i].first);
+            prefetch(hashes[i]);
+        }
+        // A resize inside the chunk only wastes the remaining prefetches
+        for (size_t i = 0; i < chunk; ++i) {
+            insertWithHash(entries[start + i].first, hashes[i], entries[start + i].second);
+        }
+    }
+}
+// Time Complexity: O(b) amortized for a batch of b entries; later duplicates win
+// Space Complexity: O(1) - one chunk of hashes on the stack
+
+template<typename K, typename V, typename Hasher>
+int FlatHashTable<K, V, Hasher>::getBatch(std::span<const K> keys, std::span<V> values, std::span<bool> found) const {
+    if (values.size() < keys.size() || found.size() < keys.size()) {
+        throw std::invalid_argument("FlatHashTable::getBatch: output spans are shorter than keys");
+    }
+
+    size_t hashes[BATCH_CHUNK];
+    int hits = 0;
+    for (size_t start = 0; start < keys.size(); start += BATCH_CHUNK) {
+        size_t chunk = std::min(BATCH_CHUNK, keys.size() - start);
+
+        for (size_t i = 0; i < chunk; ++i) {
+            hashes[i] = hashKey(keys[start + i]);
+            prefetch(hashes[i]);
+        }
+        for (size_t i = 0; i < chunk; ++i) {
+            found[start + i] = findWithHash(keys[start + i], hashes[i], values[start + i]);
+            hits += found[start + i];
+        }
+    }
+    return hits;
+}
+// Time Complexity: O(b) on average for a batch of b keys
+// Space Complexity: O(1) - one chunk of hashes on the stack
+
+template<typename K, typename V, typename Hasher>
+void FlatHashTable<K, V, Hasher>::save(const std::string& path) const {
+    static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                  "save() requires trivially copyable keys and values");
+    if (migrating) {
+        FlatHashTable settled(*this);
+        settled.setIncrementalResize(false); // Finishes the move into a single array
+        settled.save(path);
+        return;
+    }
+
+    ImageHeader header = {};
+    std::memcpy(header.magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC));
+    header.formatVersion = IMAGE_FORMAT_VERSION;
+    header.slotSize = sizeof(Slot);
+    header.keySize = sizeof(K);
+    header.valueSize = sizeof(V);
+    header.capacity = current.capacity();
+    header.count = current.count;
+    header.slotsOffset = (sizeof(ImageHeader) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+    header.distancesOffset = header.slotsOffset + header.capacity * sizeof(Slot);
+    header.controlOffset = header.distancesOffset + header.capacity;
+    header.fileSize = header.controlOffset + current.control.size();
+    header.hasherCheck = hashKey(K());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("FlatHashTable::save: cannot open " + path);
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::vector<char> padding(header.slotsOffset - sizeof(header), 0);
+    out.write(padding.data(), padding.size());
+
+    // Empty slots and padding bytes are written as zeros, never as stale memory
+    std::vector<unsigned char> chunk;
+    chunk.reserve(4096 * sizeof(Slot));
+    for (size_t i = 0; i < current.capacity(); ++i) {
+        size_t offset = chunk.size();
+        chunk.resize(offset + sizeof(Slot), 0);
+        if (current.distances[i] != EMPTY) {
+            const Slot& slot = current.slots[i];
+            std::memcpy(&chunk[offset + offsetof(Slot, key)], &slot.key, sizeof(K));
+            std::memcpy(&chunk[offset + offsetof(Slot, value)], &slot.value, sizeof(V));
+            std::memcpy(&chunk[offset + offsetof(Slot, hash)], &slot.hash, sizeof(size_t));
+        }
+        if (chunk.size() == chunk.capacity() || i + 1 == current.capacity()) {
+            out.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+            chunk.clear();
+        }
+    }
+
+    out.write(reinterpret_cast<const char*>(current.distances.data()), current.distances.size());
+    out.write(reinterpret_cast<const char*>(current.control.data()), current.control.size());
+    if (!out) {
+        throw std::runtime_error("FlatHashTable::save: write failed for " + path);
+    }
+}
+// Time Complexity: O(m) where m is the capacity (one sequential write)
+// Space Complexity: O(1) - slots are streamed through a fixed-size buffer
+
+template<typename K, typename V, typename Hasher>
+typename FlatHashTable<K, V, Hasher>::Mapped FlatHashTable<K, V, Hasher>::openMapped(const std::string& path, const Hasher& hasher) {
+    static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                  "openMapped() requires trivially copyable keys and values");
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("FlatHashTable::openMapped: cannot open " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(ImageHeader)) {
+        ::close(fd);
+        throw std::runtime_error("FlatHashTable::openMapped: " + path + " is not a table image");
+    }
+
+    size_t length = static_cast<size_t>(info.st_size);
+    void* base = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping stays valid after the descriptor is closed
+    if (base == MAP_FAILED) {
+        throw std::runtime_error("FlatHashTable::openMapped: mmap failed for " + path);
+    }
+    return Mapped(base, length, hasher);
+}
+// Time Complexity: O(1) - pages are loaded lazily by the OS as lookups touch them
+// Space Complexity: O(1) resident until pages are touched
+
+template<typename K, typename V, typename Hasher>
+FlatHashTable<K, V, Hasher>::Mapped::Mapped(void* base, size_t length, const Hasher& hasher)
+    : hasher(hasher), base(base), length(length) {
+    ImageHeader header = {};
+    if (length >= sizeof(header)) {
+        std::memcpy(&header, base, sizeof(header));
+    }
+
+    // Every array must lie inside the file, after the header and in order, with
+    // no overflow in offset + size (a truncated or corrupt file must not lead to
+    // reads past the mapping)
+    auto fits = [length](uint64_t offset, uint64_t elements, uint64_t elementSize) {
+        return offset <= length && elements <= (length - offset) / elementSize;
+    };
+    bool valid = length >= sizeof(header) &&
+                 std::memcmp(header.magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC)) == 0 &&
+                 header.formatVersion == IMAGE_FORMAT_VERSION &&
+                 header.slotSize == sizeof(Slot) && header.keySize == sizeof(K) &&
+                 header.valueSize == sizeof(V) && header.fileSize == length &&
+                 header.capacity >= GROUP_WIDTH && (header.capacity & (header.capacity - 1)) == 0 &&
+                 header.count <= header.capacity &&
+                 header.slotsOffset >= sizeof(header) && header.slotsOffset % alignof(Slot) == 0 &&
+                 fits(header.slotsOffset, header.capacity, sizeof(Slot)) &&
+                 header.distancesOffset >= header.slotsOffset + header.capacity * sizeof(Slot) &&
+                 fits(header.distancesOffset, header.capacity, 1) &&
+                 header.controlOffset >= header.distancesOffset + header.capacity &&
+                 fits(header.controlOffset, header.capacity + GROUP_WIDTH - 1, 1) &&
+                 header.controlOffset + header.capacity + GROUP_WIDTH - 1 == length;
+    if (!valid) {
+        ::munmap(base, length);
+        throw std::runtime_error("FlatHashTable::openMapped: image does not match this table type");
+    }
+    // Slots were placed by the saving table's hash function, so probing with any
+    // other one (or another Sha3Hasher key) would silently miss
+    if (header.hasherCheck != static_cast<uint64_t>(hasher(K()))) {
+        ::munmap(base, length);
+        throw std::runtime_error("FlatHashTable::openMapped: image was saved with a different hasher");
+    }
+
+    const char* bytes = static_cast<const char*>(base);
+    slots = reinterpret_cast<const Slot*>(bytes + header.slotsOffset);
+    control = reinterpret_cast<const uint8_t*>(bytes + header.controlOffset);
+    mask = header.capacity - 1;
+    shift = shiftFor(header.capacity);
+    count = header.count;
+}
+// Time Complexity: O(1) - only the header is validated
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+FlatHashTable<K, V, Hasher>::Mapped::Mapped(Mapped&& other) noexcept
+    : hasher(other.hasher), base(other.base), length(other.length), slots(other.slots), control(other.control),
+      mask(other.mask), shift(other.shift), count(other.count) {
+    other.base = nullptr;
+    other.length = 0;
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+FlatHashTable<K, V, Hasher>::Mapped::~Mapped() {
+    if (base != nullptr) {
+        ::munmap(base, length);
+    }
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+template<typename Q>
+bool FlatHashTable<K, V, Hasher>::Mapped::get(const Q& key, V& value) const {
+    return findWithHash(key, static_cast<size_t>(hasher(key)), value);
+}
+// Time Complexity: Average O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+template<typename Q>
+bool FlatHashTable<K, V, Hasher>::Mapped::findWithHash(const Q& key, size_t hash, V& value) const {
+    size_t index = probe(slots, control, mask, shift, key, hash);
+    if (index == NOT_FOUND) {
+        return false;
+    }
+    value = slots[index].value;
+    return true;
+}
+// Time Complexity: Average O(1); the same probe as the in-memory table
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+int FlatHashTable<K, V, Hasher>::Mapped::getSize() const {
+    return static_cast<int>(mask + 1);
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+template<typename K, typename V, typename Hasher>
+int FlatHashTable<K, V, Hasher>::Mapped::getCount() const {
+    return static_cast<int>(count);
+}
+// Time Complexity: O(1)
+// Space Complexity: O(1)
+
+#endif // FLAT_HASH_TABLE_H
@@ -2,14 +2,20 @@
 #include <list>
 #include <string>
 #include <cmath>
+#include <memory>
 
-template<typename K, typename V>
+// Allocator is used for every list node (and, through uses-allocator
+// construction, for pmr keys and values); see MonotonicArena.h.
+template<typename K, typename V, typename Allocator = std::allocator<std::pair<K, V>>>
 class HashTable {
 private:
     static const int INITIAL_SIZE = 10;
     static constexpr double LOAD_FACTOR = 0.80;
 
-    std::vector<std::list<std::pair<K, V>>> table;
+    typedef std::list<std::pair<K, V>, Allocator> Bucket;
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Bucket> BucketAllocator;
+
+    std::vector<Bucket, BucketAllocator> table;
     int size;
     int count;
 
@@ -17,7 +23,7 @@ private:
     void resize();
 
 public:
-    HashTable();
+    explicit HashTable(const Allocator& allocator = Allocator());
     void insert(const K& key, const V& value);
     bool remove(const K& key);
     bool get(const K& key, V& value) const;
@@ -29,29 +35,30 @@ public:
 
 // Implementation
 
-template<typename K, typename V>
-HashTable<K, V>::HashTable() : size(INITIAL_SIZE), count(0) {
-    table.resize(size);
+template<typename K, typename V, typename Allocator>
+HashTable<K, V, Allocator>::HashTable(const Allocator& allocator)
+    : table(INITIAL_SIZE, BucketAllocator(allocator)), size(INITIAL_SIZE), count(0) {
 }
 // Time Complexity: O(1) - Constant time to initialize the vector
 // Space Complexity: O(m) where m is the initial size of the table
 
-template<typename K, typename V>
-int HashTable<K, V>::hash(const K& key) const {
+template<typename K, typename V, typename Allocator>
+int HashTable<K, V, Allocator>::hash(const K& key) const {
     return std::hash<K>{}(key) % size;
 }
 // Time Complexity: O(1) - Constant time hashing and modulo operation
 // Space Complexity: O(1) - No additional space used
 
-template<typename K, typename V>
-void HashTable<K, V>::resize() {
+template<typename K, typename V, typename Allocator>
+void HashTable<K, V, Allocator>::resize() {
     int newSize = size * 2;
-    std::vector<std::list<std::pair<K, V>>> newTable(newSize);
+    std::vector<Bucket, BucketAllocator> newTable(newSize, table.get_allocator());
 
-    for (const auto& bucket : table) {
-        for (const auto& pair : bucket) {
-            int newIndex = std::hash<K>{}(pair.first) % newSize;
-            newTable[newIndex].push_back(pair);
+    for (auto& bucket : table) {
+        while (!bucket.empty()) {
+            // Relink the node instead of copying the entry: nothing is allocated
+            int newIndex = std::hash<K>{}(bucket.front().first) % newSize;
+            newTable[newIndex].splice(newTable[newIndex].end(), bucket, bucket.begin());
         }
     }
 
@@ -61,10 +68,10 @@ void HashTable<K, V>::resize() {
 // Time Complexity: O(n) where n is the number of elements in the table
 // - We iterate through all elements once
 // Space Complexity: O(m) where m is the new size of the table (2 * original size)
-// - We create a new table of double the size
+// - We create a new table of double the size; the nodes are moved, not copied
 
-template<typename K, typename V>
-void HashTable<K, V>::insert(const K& key, const V& value) {
+template<typename K, typename V, typename Allocator>
+void HashTable<K, V, Allocator>::insert(const K& key, const V& value) {
     if (getCurrentLoadFactor() >= LOAD_FACTOR) {
         resize();
     }
@@ -86,8 +93,8 @@ void HashTable<K, V>::insert(const K& key, const V& value) {
 // - Amortized: O(1) due to occasional resizing
 // Space Complexity: O(1) - Only storing one new element
 
-template<typename K, typename V>
-bool HashTable<K, V>::remove(const K& key) {
+template<typename K, typename V, typename Allocator>
+bool HashTable<K, V, Allocator>::remove(const K& key) {
     int index = hash(key);
     auto& bucket = table[index];
 
@@ -106,8 +113,8 @@ bool HashTable<K, V>::remove(const K& key) {
 // - Worst case: O(n) if all elements hash to the same index, where n is the number of elements
 // Space Complexity: O(1) - No additional space used
 
-template<typename K, typename V>
-bool HashTable<K, V>::get(const K& key, V& value) const {
+template<typename K, typename V, typename Allocator>
+bool HashTable<K, V, Allocator>::get(const K& key, V& value) const {
     int index = hash(key);
     const auto& bucket = table[index];
 
@@ -125,8 +132,8 @@ bool HashTable<K, V>::get(const K& key, V& value) const {
 // - Worst case: O(n) if all elements hash to the same index, where n is the number of elements
 // Space Complexity: O(1) - No additional space used
 
-template<typename K, typename V>
-bool HashTable<K, V>::update(const K& key, const V& value) {
+template<typename K, typename V, typename Allocator>
+bool HashTable<K, V, Allocator>::update(const K& key, const V& value) {
     int index = hash(key);
     auto& bucket = table[index];
 
@@ -144,22 +151,22 @@ bool HashTable<K, V>::update(const K& key, const V& value) {
 // - Worst case: O(n) if all elements hash to the same index, where n is the number of elements
 // Space Complexity: O(1) - No additional space used
 
-template<typename K, typename V>
-int HashTable<K, V>::getSize() const {
+template<typename K, typename V, typename Allocator>
+int HashTable<K, V, Allocator>::getSize() const {
     return size;
 }
 // Time Complexity: O(1) - Constant time to return a value
 // Space Complexity: O(1) - No additional space used
 
-template<typename K, typename V>
-int HashTable<K, V>::getCount() const {
+template<typename K, typename V, typename Allocator>
+int HashTable<K, V, Allocator>::getCount() const {
     return count;
 }
 // Time Complexity: O(1) - Constant time to return a value
 // Space Complexity: O(1) - No additional space used
 
-template<typename K, typename V>
-double HashTable<K, V>::getCurrentLoadFactor() const {
+template<typename K, typename V, typename Allocator>
+double HashTable<K, V, Allocator>::getCurrentLoadFactor() const {
     return static_cast<double>(count) / size;
 }
 // Time Complexity: O(1) - Constant time for division
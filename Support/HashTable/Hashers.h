@@ -0,0 +1,129 @@
+#ifndef HASHERS_H
+#define HASHERS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <type_traits>
+
+// Hash functions that can be plugged into FlatHashTable as its Hasher parameter.
+// A hasher is a copyable function object returning a 64-bit hash; hashers of
+// std::string keys are "transparent" and also accept std::string_view, so
+// lookups never have to build a string.
+//
+// The table reduces the hash to a slot with multiply-shift (see FlatHashTable),
+// which already spreads weak hashes such as the identity std::hash<int>.
+// Sha3Hasher (keyed, collision resistant) lives in Sha3Hasher.h because it
+// needs Hash/sha3.c linked in.
+
+namespace wy {
+    // Constants and mixing steps of wyhash (Wang Yi, public domain)
+    const uint64_t SECRET0 = 0xa0761d6478bd642fULL;
+    const uint64_t SECRET1 = 0xe7037ed1a0b428dbULL;
+    const uint64_t SECRET2 = 0x8ebc6af09c88c6e3ULL;
+    const uint64_t SECRET3 = 0x589965cc75374cc3ULL;
+
+    // 64x64 -> 128-bit multiply, folded back to 64 bits
+    inline uint64_t mix(uint64_t a, uint64_t b) {
+        __uint128_t product = static_cast<__uint128_t>(a) * b;
+        return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+    }
+
+    inline uint64_t read8(const uint8_t* p) { uint64_t v; std::memcpy(&v, p, 8); return v; }
+    inline uint64_t read4(const uint8_t* p) { uint32_t v; std::memcpy(&v, p, 4); return v; }
+    inline uint64_t read3(const uint8_t* p, size_t k) {
+        return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+    }
+
+    inline uint64_t hashBytes(const void* data, size_t length, uint64_t seed) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        seed ^= mix(seed ^ SECRET0, SECRET1);
+        uint64_t a, b;
+
+        if (length <= 16) {
+            if (length >= 4) {
+                a = (read4(p) << 32) | read4(p + ((length >> 3) << 2));
+                b = (read4(p + length - 4) << 32) | read4(p + length - 4 - ((length >> 3) << 2));
+            } else if (length > 0) {
+                a = read3(p, length);
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            size_t i = length;
+            if (i > 48) {
+                uint64_t seed1 = seed, seed2 = seed;
+                do {
+                    seed = mix(read8(p) ^ SECRET1, read8(p + 8) ^ seed);
+                    seed1 = mix(read8(p + 16) ^ SECRET2, read8(p + 24) ^ seed1);
+                    seed2 = mix(read8(p + 32) ^ SECRET3, read8(p + 40) ^ seed2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= seed1 ^ seed2;
+            }
+            while (i > 16) {
+                seed = mix(read8(p) ^ SECRET1, read8(p + 8) ^ seed);
+                p += 16;
+                i -= 16;
+            }
+            a = read8(p + i - 16);
+            b = read8(p + i - 8);
+        }
+
+        __uint128_t product = static_cast<__uint128_t>(a ^ SECRET1) * (b ^ seed);
+        a = static_cast<uint64_t>(product);
+        b = static_cast<uint64_t>(product >> 64);
+        return mix(a ^ SECRET0 ^ length, b ^ SECRET1);
+    }
+    // Time Complexity: O(n) where n is the number of bytes, 16-48 bytes per step
+    // Space Complexity: O(1)
+}
+
+// Default hasher: wyhash-style. Integers and enums are mixed with one 128-bit
+// multiply; any other type falls back to std::hash followed by the same mix.
+template<typename K, typename Enable = void>
+struct WyHasher {
+    size_t operator()(const K& key) const {
+        return static_cast<size_t>(wy::mix(static_cast<uint64_t>(std::hash<K>{}(key)) ^ wy::SECRET0, wy::SECRET1));
+    }
+};
+
+template<typename K>
+struct WyHasher<K, typename std::enable_if<std::is_integral<K>::value || std::is_enum<K>::value>::type> {
+    size_t operator()(K key) const {
+        return static_cast<size_t>(wy::mix(static_cast<uint64_t>(key) ^ wy::SECRET0, wy::SECRET1));
+    }
+};
+
+template<>
+struct WyHasher<std::string> {
+    using is_transparent = void;
+    size_t operator()(std::string_view key) const {
+        return static_cast<size_t>(wy::hashBytes(key.data(), key.size(), wy::SECRET2));
+    }
+};
+
+// Plain std::hash (identity for integers on libstdc++); cheapest to compute and
+// safe only because the table reduces hashes with multiply-shift
+template<typename K>
+struct StdHasher {
+    size_t operator()(const K& key) const {
+        return std::hash<K>{}(key);
+    }
+};
+
+template<>
+struct StdHasher<std::string> {
+    using is_transparent = void;
+    size_t operator()(std::string_view key) const {
+        // std::hash<std::string_view> is guaranteed to agree with std::hash<std::string>
+        return std::hash<std::string_view>{}(key);
+    }
+};
+
+#endif // HASHERS_H
@@ -0,0 +1,126 @@
+#ifndef MONOTONIC_ARENA_H
+#define MONOTONIC_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+// Monotonic arena for memo tables whose entries all die together.
+// Memory is handed out by bumping a pointer through large chunks taken from
+// an upstream resource; deallocate() does nothing, and release() returns every
+// chunk at once. Chunks double in size, so n bytes cost O(log n) upstream
+// allocations no matter how many objects they hold.
+//
+// It is a std::pmr::memory_resource, so it plugs into the tables through
+// ArenaAllocator<T> (std::pmr::polymorphic_allocator). With pmr keys and values,
+// e.g. HashTable<std::pmr::string, std::pmr::vector<int>, ArenaAllocator<...>>,
+// the list node, the key's characters and the value's elements of every entry
+// all come from the arena, and uses-allocator construction passes the arena
+// down automatically.
+//
+// Freed memory is never reused, so the arena suits caches that grow and are
+// then dropped as a whole, not caches that evict. Not thread-safe.
+class MonotonicArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    explicit MonotonicArena(size_t initialChunkSize = DEFAULT_CHUNK_SIZE,
+                            std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+    ~MonotonicArena() override;
+
+    void release();
+    size_t getAllocationCount() const { return allocations; }
+    size_t getBytesAllocated() const { return bytesAllocated; }
+    size_t getChunkCount() const { return chunkCount; }
+
+private:
+    struct Chunk {
+        Chunk* next;
+        size_t size;   // Bytes including this header
+    };
+
+    std::pmr::memory_resource* upstream;
+    Chunk* chunks;          // Most recent first
+    char* cursor;           // Next free byte of the newest chunk
+    char* end;
+    size_t nextChunkSize;
+    size_t initialChunkSize;
+    size_t allocations;
+    size_t bytesAllocated;
+    size_t chunkCount;
+
+    void addChunk(size_t minimumBytes);
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+template<typename T>
+using ArenaAllocator = std::pmr::polymorphic_allocator<T>;
+
+// Implementation
+
+inline MonotonicArena::MonotonicArena(size_t initialChunkSize, std::pmr::memory_resource* upstream)
+    : upstream(upstream), chunks(nullptr), cursor(nullptr), end(nullptr),
+      nextChunkSize(initialChunkSize), initialChunkSize(initialChunkSize),
+      allocations(0), bytesAllocated(0), chunkCount(0) {
+}
+// Time Complexity: O(1) - no memory is taken until the first allocation
+// Space Complexity: O(1)
+
+inline MonotonicArena::~MonotonicArena() {
+    release();
+}
+// Time Complexity: O(c) where c is the number of chunks
+// Space Complexity: O(1)
+
+inline void MonotonicArena::release() {
+    while (chunks != nullptr) {
+        Chunk* next = chunks->next;
+        upstream->deallocate(chunks, chunks->size, alignof(std::max_align_t));
+        chunks = next;
+    }
+    cursor = end = nullptr;
+    nextChunkSize = initialChunkSize;
+    allocations = bytesAllocated = chunkCount = 0;
+}
+// Time Complexity: O(c) where c is the number of chunks, O(log n) for n bytes;
+// independent of how many objects were allocated
+// Space Complexity: O(1)
+
+inline void MonotonicArena::addChunk(size_t minimumBytes) {
+    size_t size = nextChunkSize;
+    while (size < minimumBytes + sizeof(Chunk)) {
+        size *= 2;
+    }
+    Chunk* chunk = static_cast<Chunk*>(upstream->allocate(size, alignof(std::max_align_t)));
+    chunk->next = chunks;
+    chunk->size = size;
+    chunks = chunk;
+    cursor = reinterpret_cast<char*>(chunk + 1);
+    end = reinterpret_cast<char*>(chunk) + size;
+    nextChunkSize = size * 2;
+    chunkCount++;
+}
+// Time Complexity: O(1) plus one upstream allocation
+// Space Complexity: O(s) where s is the chunk size
+
+inline void* MonotonicArena::do_allocate(size_t bytes, size_t alignment) {
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(cursor) + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    if (cursor == nullptr || aligned + bytes > reinterpret_cast<uintptr_t>(end)) {
+        addChunk(bytes + alignment);
+        aligned = (reinterpret_cast<uintptr_t>(cursor) + alignment - 1) & ~(uintptr_t(alignment) - 1);
+    }
+    cursor = reinterpret_cast<char*>(aligned + bytes);
+    allocations++;
+    bytesAllocated += bytes;
+    return reinterpret_cast<void*>(aligned);
+}
+// Time Complexity: O(1) - a pointer bump; a new chunk only when the current one is full
+// Space Complexity: O(1) amortized
+
+#endif // MONOTONIC_ARENA_H
@@ -0,0 +1,89 @@
+#ifndef SHA3_HASHER_H
+#define SHA3_HASHER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// sha3.h is a C header without extern "C" guards of its own
+extern "C" {
+#include "Hash/sha3.h"
+}
+
+// Keyed hasher for FlatHashTable, built on the SHA3-256 implementation in
+// Hash/sha3.c (link it in: cc -c Hash/sha3.c). The hash is the first 8 bytes
+// of SHA3-256(secret || key bytes). Without the secret nobody can predict
+// which keys share a slot, so an adversary feeding keys into a memo table
+// cannot force long probe runs or the resizes that follow them. It is much
+// slower than WyHasher, so use it only for keys that come from outside.
+//
+// SHA3 has no length-extension weakness, so prefixing the secret is a sound
+// MAC. The sponge state after absorbing the secret is computed once in the
+// constructor; every hash copies it and absorbs only the key.
+//
+// A default-constructed hasher draws a random 32-byte secret, so two tables
+// hash differently. Give the same secret explicitly to reopen a saved image.
+class Sha3KeyedHash {
+public:
+    static constexpr size_t SECRET_BYTES = 32;
+
+    Sha3KeyedHash() {
+        std::random_device device;
+        uint32_t secret[SECRET_BYTES / sizeof(uint32_t)];
+        for (uint32_t& word : secret) {
+            word = device();
+        }
+        absorbSecret(secret, sizeof(secret));
+    }
+
+    explicit Sha3KeyedHash(std::string_view secret) {
+        absorbSecret(secret.data(), secret.size());
+    }
+
+protected:
+    size_t hashBytes(const void* data, size_t length) const {
+        sha3_context context = keyed;
+        sha3_Update(&context, data, length);
+        const void* digest = sha3_Finalize(&context);
+        uint64_t h;
+        std::memcpy(&h, digest, sizeof(h));
+        return static_cast<size_t>(h);
+    }
+    // Time Complexity: O(n) where n is the number of bytes (one Keccak-f per 136 bytes)
+    // Space Complexity: O(1) - one sponge state on the stack
+
+private:
+    sha3_context keyed; // Sponge state after absorbing the secret
+
+    void absorbSecret(const void* secret, size_t length) {
+        sha3_Init256(&keyed);
+        sha3_Update(&keyed, secret, length);
+    }
+};
+
+// Keys are hashed by their object representation, so K must not have padding
+// bytes (integers, enums and packed structs of them are fine)
+template<typename K>
+struct Sha3Hasher : Sha3KeyedHash {
+    using Sha3KeyedHash::Sha3KeyedHash;
+    size_t operator()(const K& key) const {
+        static_assert(std::has_unique_object_representations<K>::value,
+                      "Sha3Hasher needs keys whose bytes determine their value (no padding, no floats)");
+        return hashBytes(&key, sizeof(K));
+    }
+};
+
+template<>
+struct Sha3Hasher<std::string> : Sha3KeyedHash {
+    using Sha3KeyedHash::Sha3KeyedHash;
+    using is_transparent = void;
+    size_t operator()(std::string_view key) const {
+        return hashBytes(key.data(), key.size());
+    }
+};
+
+#endif // SHA3_HASHER_H
@@ -0,0 +1,363 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <optional>
+#include <memory>
+#include <span>
+#include <new>
+#include <cstdlib>
+#include <memory_resource>
+#include "HashTable.h"
+#include "FlatHashTable.h"
+#include "Sha3Hasher.h"
+#include "MonotonicArena.h"
+#include "../Utilities/measureTime.h"
+
+// Benchmark: chained HashTable vs. open-addressing FlatHashTable
+// Usage: ./benchmark [number of keys]
+// Build: cc -O2 -c Hash/sha3.c && g++ -std=c++20 -O2 benchmark.cpp sha3.o -o benchmark
+// Build with -DFLAT_HASH_TABLE_NO_SIMD to measure the scalar group-probing fallback.
+
+// Every global operator new is counted, so the allocator section can report
+// how many heap allocations a table really makes
+static size_t heapAllocations = 0;
+
+void* operator new(size_t bytes) {
+    heapAllocations++;
+    if (void* p = std::malloc(bytes == 0 ? 1 : bytes)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void* operator new(size_t bytes, std::align_val_t alignment) {
+    heapAllocations++;
+    size_t align = static_cast<size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (bytes + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+// GCC cannot see that these pair with the replacements above
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+template<typename Table, typename K>
+void runBenchmark(const std::string& name, const std::vector<K>& keys, const std::vector<K>& missing) {
+    Table table;
+    long long checksum = 0;
+
+    double insertTime = ExecutionTimer::measureExecutionTime([&]() {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            table.insert(keys[i], static_cast<int>(i));
+        }
+    });
+
+    double hitTime = ExecutionTimer::measureExecutionTime([&]() {
+        int value;
+        for (const auto& key : keys) {
+            if (table.get(key, value)) checksum += value;
+        }
+    });
+
+    double missTime = ExecutionTimer::measureExecutionTime([&]() {
+        int value;
+        for (const auto& key : missing) {
+            if (table.get(key, value)) checksum += value;
+        }
+    });
+
+    double removeTime = ExecutionTimer::measureExecutionTime([&]() {
+        for (const auto& key : keys) {
+            table.remove(key);
+        }
+    });
+
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(10) << insertTime
+              << std::setw(10) << hitTime
+              << std::setw(10) << missTime
+              << std::setw(10) << removeTime
+              << "   (checksum " << checksum << ")" << std::endl;
+}
+
+void printHeader(const std::string& title) {
+    std::cout << "\n" << title << std::endl;
+    std::cout << std::left << std::setw(28) << "table (ms)"
+              << std::right << std::setw(10) << "insert"
+              << std::setw(10) << "get hit"
+              << std::setw(10) << "get miss"
+              << std::setw(10) << "remove" << std::endl;
+}
+
+// Latency of every single insert, to show the pauses caused by resizing
+void runLatencyBenchmark(const std::string& name, const std::vector<int>& keys, bool incremental) {
+    FlatHashTable<int, int> table;
+    table.setIncrementalResize(incremental);
+    std::vector<double> latencies(keys.size());
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        table.insert(keys[i], static_cast<int>(i));
+        auto end = std::chrono::high_resolution_clock::now();
+        latencies[i] = std::chrono::duration<double, std::micro>(end - start).count();
+    }
+
+    double total = 0;
+    for (double latency : latencies) total += latency;
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(10) << total / 1000.0
+              << std::setw(10) << latencies[latencies.size() * 999 / 1000]
+              << std::setw(10) << latencies[latencies.size() * 99999 / 100000]
+              << std::setw(12) << latencies.back() << std::endl;
+}
+
+// One call per key vs. insertBatch/getBatch with prefetching
+void runBatchBenchmark(const std::vector<int>& keys) {
+    std::vector<std::pair<int, int>> entries(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        entries[i] = {keys[i], static_cast<int>(i)};
+    }
+    std::vector<int> values(keys.size());
+    std::unique_ptr<bool[]> found(new bool[keys.size()]);
+    long long checksum = 0;
+
+    FlatHashTable<int, int> single;
+    single.reserve(static_cast<int>(keys.size()));
+    double singleInsert = ExecutionTimer::measureExecutionTime([&]() {
+        for (const auto& entry : entries) {
+            single.insert(entry.first, entry.second);
+        }
+    });
+    double singleGet = ExecutionTimer::measureExecutionTime([&]() {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (single.get(keys[i], values[i])) checksum += values[i];
+        }
+    });
+
+    FlatHashTable<int, int> batched;
+    batched.reserve(static_cast<int>(keys.size()));
+    double batchInsert = ExecutionTimer::measureExecutionTime([&]() {
+        batched.insertBatch(entries);
+    });
+    double batchGet = ExecutionTimer::measureExecutionTime([&]() {
+        batched.getBatch(keys, values, std::span<bool>(found.get(), keys.size()));
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (found[i]) checksum += values[i];
+        }
+    });
+
+    std::cout << "\nBatch API, int keys, table pre-reserved" << std::endl;
+    std::cout << std::left << std::setw(28) << "calls (ms)"
+              << std::right << std::setw(10) << "insert" << std::setw(10) << "get" << std::endl;
+    std::cout << std::left << std::setw(28) << "one at a time"
+              << std::right << std::setw(10) << singleInsert << std::setw(10) << singleGet << std::endl;
+    std::cout << std::left << std::setw(28) << "insertBatch / getBatch"
+              << std::right << std::setw(10) << batchInsert << std::setw(10) << batchGet
+              << "   (checksum " << checksum << ")" << std::endl;
+}
+
+// Cold start: rebuilding a memo table vs. mapping a saved image of it
+void runSnapshotBenchmark(const std::vector<int>& keys) {
+    const std::string path = "benchmark_table.bin";
+    FlatHashTable<int, int> table;
+    long long checksum = 0;
+
+    double buildTime = ExecutionTimer::measureExecutionTime([&]() {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            table.insert(keys[i], static_cast<int>(i));
+        }
+    });
+    double saveTime = ExecutionTimer::measureExecutionTime([&]() { table.save(path); });
+
+    std::optional<FlatHashTable<int, int>::Mapped> mapped;
+    double openTime = ExecutionTimer::measureExecutionTime([&]() {
+        mapped.emplace(FlatHashTable<int, int>::openMapped(path));
+    });
+    double lookupTime = ExecutionTimer::measureExecutionTime([&]() {
+        int value;
+        for (const auto& key : keys) {
+            if (mapped->get(key, value)) checksum += value;
+        }
+    });
+    mapped.reset();
+    std::remove(path.c_str());
+
+    std::cout << "\nSnapshot (ms): build " << buildTime << ", save " << saveTime
+              << ", openMapped " << openTime << ", get all from mapping " << lookupTime
+              << "   (checksum " << checksum << ")" << std::endl;
+}
+
+// Quality and cost of each Hasher: full 64-bit hash collisions, how far entries
+// end up from their home slot, and the time to hash, insert and look up
+template<typename K, typename Hasher>
+void runHasherBenchmark(const std::string& name, const std::vector<K>& keys, const Hasher& hasher = Hasher()) {
+    std::vector<size_t> hashes(keys.size());
+    double hashTime = ExecutionTimer::measureExecutionTime([&]() {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            hashes[i] = hasher(keys[i]);
+        }
+    });
+    std::sort(hashes.begin(), hashes.end());
+    size_t collisions = hashes.size() - (std::unique(hashes.begin(), hashes.end()) - hashes.begin());
+
+    FlatHashTable<K, int, Hasher> table(hasher);
+    long long checksum = 0;
+    double insertTime = ExecutionTimer::measureExecutionTime([&]() {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            table.insert(keys[i], static_cast<int>(i));
+        }
+    });
+    double getTime = ExecutionTimer::measureExecutionTime([&]() {
+        int value;
+        for (const auto& key : keys) {
+            if (table.get(key, value)) checksum += value;
+        }
+    });
+
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(10) << hashTime * 1e6 / keys.size()
+              << std::setw(10) << insertTime
+              << std::setw(10) << getTime
+              << std::setw(12) << collisions
+              << std::setw(10) << table.getAverageProbeDistance()
+              << "   (checksum " << checksum << ")" << std::endl;
+}
+
+void printHasherHeader(const std::string& title) {
+    std::cout << "\n" << title << std::endl;
+    std::cout << std::left << std::setw(28) << "hasher"
+              << std::right << std::setw(10) << "ns/hash"
+              << std::setw(10) << "insert ms"
+              << std::setw(10) << "get ms"
+              << std::setw(12) << "64-bit coll"
+              << std::setw(10) << "avg dist" << std::endl;
+}
+
+// Memo cache shaped like Act1.2's (string key -> vector<int> of coin counts):
+// default allocator vs. every node, key and value in one MonotonicArena
+template<typename Table, typename Key, typename Value>
+void runAllocatorCase(const std::string& name, Table& table, const std::vector<std::string>& keys,
+                      Value& value, std::unique_ptr<Table>& owner, MonotonicArena* arena) {
+    size_t before = heapAllocations;
+    double insertTime = ExecutionTimer::measureExecutionTime([&]() {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            value[0] = static_cast<int>(i); // Same buffer every time: only the table allocates
+            table.insert(Key(keys[i].begin(), keys[i].end(), typename Key::allocator_type()), value);
+        }
+    });
+    size_t allocations = heapAllocations - before;
+
+    double teardownTime = ExecutionTimer::measureExecutionTime([&]() {
+        owner.reset();
+        if (arena != nullptr) arena->release();
+    });
+
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(14) << allocations
+              << std::setw(12) << static_cast<double>(allocations) / keys.size()
+              << std::setw(10) << insertTime
+              << std::setw(12) << teardownTime << std::endl;
+}
+
+void runAllocatorBenchmark(const std::vector<std::string>& keys) {
+    const size_t COINS = 8;
+    std::cout << "\nAllocator, std::string -> std::vector<int>(" << COINS << ") entries" << std::endl;
+    std::cout << std::left << std::setw(28) << "allocator"
+              << std::right << std::setw(14) << "heap allocs"
+              << std::setw(12) << "per entry"
+              << std::setw(10) << "insert ms"
+              << std::setw(12) << "teardown ms" << std::endl;
+
+    typedef HashTable<std::string, std::vector<int>> DefaultTable;
+    std::vector<int> value(COINS, 1);
+    auto defaultTable = std::make_unique<DefaultTable>();
+    runAllocatorCase<DefaultTable, std::string>("std::allocator", *defaultTable, keys, value, defaultTable, nullptr);
+
+    typedef std::pair<std::pmr::string, std::pmr::vector<int>> Entry;
+    typedef HashTable<std::pmr::string, std::pmr::vector<int>, ArenaAllocator<Entry>> ArenaTable;
+    MonotonicArena arena;
+    std::pmr::vector<int> pmrValue(COINS, 1);
+    auto arenaTable = std::make_unique<ArenaTable>(ArenaAllocator<Entry>(&arena));
+    runAllocatorCase<ArenaTable, std::pmr::string>("MonotonicArena", *arenaTable, keys, pmrValue, arenaTable, &arena);
+}
+
+int main(int argc, char* argv[]) {
+    size_t n = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    std::mt19937_64 gen(42);
+
+    std::vector<int> intKeys(n), intMissing(n);
+    for (size_t i = 0; i < n; ++i) {
+        intKeys[i] = static_cast<int>(gen() >> 33);
+        intMissing[i] = -1 - static_cast<int>(gen() >> 33);
+    }
+
+    std::vector<std::string> strKeys(n), strMissing(n);
+    for (size_t i = 0; i < n; ++i) {
+        strKeys[i] = std::to_string(intKeys[i] / 100.0);
+        strMissing[i] = "x" + std::to_string(intMissing[i]);
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Keys: " << n << std::endl;
+
+    printHeader("int keys");
+    runBenchmark<HashTable<int, int>>("HashTable (chained)", intKeys, intMissing);
+    runBenchmark<FlatHashTable<int, int>>("FlatHashTable (robin hood)", intKeys, intMissing);
+
+    printHeader("std::string keys");
+    runBenchmark<HashTable<std::string, int>>("HashTable (chained)", strKeys, strMissing);
+    runBenchmark<FlatHashTable<std::string, int>>("FlatHashTable (robin hood)", strKeys, strMissing);
+
+    std::cout << "\nSingle insert latency, int keys" << std::endl;
+    std::cout << std::left << std::setw(28) << "resize mode"
+              << std::right << std::setw(10) << "total ms"
+              << std::setw(10) << "p99.9 us"
+              << std::setw(10) << "p99.999"
+              << std::setw(12) << "max us" << std::endl;
+    runLatencyBenchmark("blocking resize", intKeys, false);
+    runLatencyBenchmark("incremental resize", intKeys, true);
+
+    runBatchBenchmark(intKeys);
+    runSnapshotBenchmark(intKeys);
+    runAllocatorBenchmark(strKeys);
+
+    // Distinct keys that are all multiples of 4096: the low bits of an identity
+    // hash are constant, which is what masking the low bits used to depend on
+    std::vector<int> stridedKeys(n);
+    for (size_t i = 0; i < n; ++i) {
+        stridedKeys[i] = static_cast<int>(i) << 12;
+    }
+    std::vector<std::string> distinctStrings(strKeys);
+    std::sort(distinctStrings.begin(), distinctStrings.end());
+    distinctStrings.erase(std::unique(distinctStrings.begin(), distinctStrings.end()), distinctStrings.end());
+    std::vector<int> distinctInts(intKeys);
+    std::sort(distinctInts.begin(), distinctInts.end());
+    distinctInts.erase(std::unique(distinctInts.begin(), distinctInts.end()), distinctInts.end());
+
+    printHasherHeader("Hashers, random int keys");
+    runHasherBenchmark<int, StdHasher<int>>("StdHasher", distinctInts);
+    runHasherBenchmark<int, WyHasher<int>>("WyHasher (default)", distinctInts);
+    runHasherBenchmark<int, Sha3Hasher<int>>("Sha3Hasher (keyed)", distinctInts);
+
+    printHasherHeader("Hashers, int keys in steps of 4096");
+    runHasherBenchmark<int, StdHasher<int>>("StdHasher", stridedKeys);
+    runHasherBenchmark<int, WyHasher<int>>("WyHasher (default)", stridedKeys);
+    runHasherBenchmark<int, Sha3Hasher<int>>("Sha3Hasher (keyed)", stridedKeys);
+
+    printHasherHeader("Hashers, std::string keys");
+    runHasherBenchmark<std::string, StdHasher<std::string>>("StdHasher", distinctStrings);
+    runHasherBenchmark<std::string, WyHasher<std::string>>("WyHasher (default)", distinctStrings);
+    runHasherBenchmark<std::string, Sha3Hasher<std::string>>("Sha3Hasher (keyed)", distinctStrings);
+
+    return 0;
+}
@@ -1,12 +1,16 @@
 #include <iostream>
 #include <string>
 #include <limits>
-#include "../HashTable/HashTable.h"
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "../HashTable/FlatHashTable.h"
+#include "../HashTable/ConcurrentHashTable.h"
 
-unsigned long long fibMemoized(int n, HashTable<int, unsigned long long>& memo, bool& overflowed);
+unsigned long long fibMemoized(int n, FlatHashTable<int, unsigned long long>& memo, bool& overflowed);
 
 unsigned long long fibonacci(int n) {
-    HashTable<int, unsigned long long> memo;
+    FlatHashTable<int, unsigned long long> memo;
     bool overflowed = false;
     unsigned long long result = fibMemoized(n, memo, overflowed);
     if (overflowed) {
@@ -18,7 +22,7 @@ unsigned long long fibonacci(int n) {
 unsigned long long fibTabulated(int n) {
     if (n <= 1) return n;
 
-    HashTable<int, unsigned long long> memo;
+    FlatHashTable<int, unsigned long long> memo;
     memo.insert(0, 0);
     memo.insert(1, 1);
 
@@ -34,7 +38,7 @@ unsigned long long fibTabulated(int n) {
     return value;
 }
 
-unsigned long long fibMemoized(int n, HashTable<int, unsigned long long>& memo, bool& overflowed) {
+unsigned long long fibMemoized(int n, FlatHashTable<int, unsigned long long>& memo, bool& overflowed) {
     if (overflowed) return 0;
     if (n <= 1) return n;
 
@@ -62,6 +66,39 @@ unsigned long long fibMemoized(int n, HashTable<int, unsigned long long>& memo,
     return overflowed ? 0 : result;
 }
 
+// Memo compartido entre hilos; el valor máximo marca un resultado desbordado
+typedef ConcurrentHashTable<int, unsigned long long, 16, true> SharedMemo;
+const unsigned long long FIB_OVERFLOW = std::numeric_limits<unsigned long long>::max();
+
+unsigned long long fibShared(int n, SharedMemo& memo) {
+    if (n <= 1) return n;
+
+    // getOrCompute garantiza que cada n se calcula una sola vez aunque varios hilos lo pidan
+    return memo.getOrCompute(n, [&]() {
+        unsigned long long prev1 = fibShared(n - 1, memo);
+        unsigned long long prev2 = fibShared(n - 2, memo);
+        if (prev1 == FIB_OVERFLOW || prev2 == FIB_OVERFLOW || prev1 > FIB_OVERFLOW - prev2) {
+            return FIB_OVERFLOW;
+        }
+        return prev1 + prev2;
+    });
+}
+
+unsigned long long fibParallel(int n, int threads) {
+    SharedMemo memo;
+    std::vector<std::thread> workers;
+
+    // Cada hilo arranca en un punto distinto de la serie y todos comparten el mismo memo
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&memo, n, t]() { fibShared(std::max(0, n - t), memo); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    return fibShared(n, memo);
+}
+
 int main() {
     int n;
     std::cout << "Ingresa un número de de la seria de Fibonacci a calcular: ";
@@ -85,5 +122,13 @@ int main() {
         std::cout << "El " << n << "Resultado es demasiado grande para representar con unsigned long long." << std::endl;
     }
 
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    unsigned long long result3 = fibParallel(n2, threads);
+    if (result3 != FIB_OVERFLOW) {
+        std::cout << "Resultado con memo concurrente (" << threads << " hilos): " << result3 << std::endl;
+    } else {
+        std::cout << "El " << n2 << " Resultado concurrente es demasiado grande para representar con unsigned long long." << std::endl;
+    }
+
     return 0;
 }
\ No newline at end of file
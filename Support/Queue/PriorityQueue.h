@@ -84,4 +84,125 @@ public:
     }
 };
 
+// Cola de prioridad indexada sobre un heap d-ario: cada elemento es un id en
+// [0, capacity) con su prioridad, y position guarda dónde está cada id en el
+// heap para poder mejorar su prioridad (decrease_key) sin buscarlo. Igual que
+// PriorityQueue, comp(a, b) indica que a va debajo de b.
+template<typename T, typename Compare = std::less<T>, int D = 4>
+class IndexedPriorityQueue {
+private:
+    std::vector<size_t> heap;     // ids
+    std::vector<T> priority;      // prioridad por id
+    std::vector<int> position;    // posición de cada id en heap, -1 si no está
+    Compare comp;
+
+    bool below(int a, int b) const {
+        return comp(priority[heap[a]], priority[heap[b]]);
+    }
+
+    void place(int index, size_t id) {
+        heap[index] = id;
+        position[id] = index;
+    }
+
+    void heapifyUp(int index) {
+        size_t id = heap[index];
+        while (index > 0) {
+            int parent = (index - 1) / D;
+            if (!comp(priority[heap[parent]], priority[id])) {
+                break;
+            }
+            place(index, heap[parent]);
+            index = parent;
+        }
+        place(index, id);
+    }
+
+    void heapifyDown(int index) {
+        int size = heap.size();
+        size_t id = heap[index];
+        while (true) {
+            int firstChild = D * index + 1;
+            if (firstChild >= size) {
+                break;
+            }
+            int best = firstChild;
+            int lastChild = std::min(firstChild + D, size);
+            for (int child = firstChild + 1; child < lastChild; ++child) {
+                if (below(best, child)) {
+                    best = child;
+                }
+            }
+            if (!comp(priority[id], priority[heap[best]])) {
+                break;
+            }
+            place(index, heap[best]);
+            index = best;
+        }
+        place(index, id);
+    }
+
+public:
+    explicit IndexedPriorityQueue(size_t capacity, const Compare& compare = Compare())
+        : priority(capacity), position(capacity, -1), comp(compare) {}
+
+    void push(size_t id, const T& value) {
+        if (contains(id)) throw std::invalid_argument("IndexedPriorityQueue already contains id");
+        priority[id] = value;
+        heap.push_back(id);
+        heapifyUp(heap.size() - 1);
+    }
+
+    // La nueva prioridad no puede ser peor que la actual
+    void decrease_key(size_t id, const T& value) {
+        if (!contains(id)) throw std::out_of_range("IndexedPriorityQueue does not contain id");
+        priority[id] = value;
+        heapifyUp(position[id]);
+    }
+
+    void pop() {
+        if (empty()) return;
+        position[heap[0]] = -1;
+        size_t last = heap.back();
+        heap.pop_back();
+        if (!empty()) {
+            place(0, last);
+            heapifyDown(0);
+        }
+    }
+
+    size_t top() const {
+        if (empty()) throw std::out_of_range("IndexedPriorityQueue is empty");
+        return heap[0];
+    }
+
+    const T& topPriority() const {
+        if (empty()) throw std::out_of_range("IndexedPriorityQueue is empty");
+        return priority[heap[0]];
+    }
+
+    bool contains(size_t id) const {
+        return position[id] >= 0;
+    }
+
+    const T& priorityOf(size_t id) const {
+        return priority[id];
+    }
+
+    bool empty() const {
+        return heap.empty();
+    }
+
+    size_t size() const {
+        return heap.size();
+    }
+
+    void clear() {
+        for (size_t id : heap) {
+            position[id] = -1;
+        }
+        heap.clear();
+    }
+};
+
 #endif // PRIORITY_QUEUE_H
\ No newline at end of file